@@ -0,0 +1,362 @@
+#ifndef BOOST_ASIO_ANY_EXECUTOR_HPP
+#define BOOST_ASIO_ANY_EXECUTOR_HPP
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include "executor.hpp"
+#include "executor_op.hpp"
+#include "fenced_block.hpp"
+#include "io_context.hpp"
+#include "recycling_allocator.hpp"
+#include "scheduler_operation.hpp"
+#include "service_registry_helpers.hpp"
+#include "strand.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+namespace detail {
+
+// ֱӽչõscheduler_operationִ any_executorͶʱٰװһ
+template <typename Executor>
+struct executor_operation_traits
+{
+  static const bool is_specialized = false;
+};
+
+template <>
+struct executor_operation_traits<io_context::executor_type>
+{
+  static const bool is_specialized = true;
+
+  static bool running_in_this_thread(const io_context::executor_type& ex) { return ex.running_in_this_thread(); }
+
+  static void post(const io_context::executor_type& ex, scheduler_operation* op, bool is_continuation)
+  {
+    use_service<io_context_impl>(ex.context()).post_immediate_completion(op, is_continuation);
+  }
+};
+
+template <typename Executor>
+struct executor_operation_traits<strand<Executor>>
+{
+  static const bool is_specialized = true;
+
+  static bool running_in_this_thread(const strand<Executor>& s) { return s.running_in_this_thread(); }
+
+  static void post(const strand<Executor>& s, scheduler_operation* op, bool is_continuation)
+  {
+    Executor ex(s.executor_);
+    strand_executor_service::post_operation(s.impl_, ex, op, recycling_allocator<void>(), is_continuation);
+  }
+};
+
+// ѹõĲװɺ ûػexecutor_operation_traitsִ
+class operation_function
+{
+ public:
+  explicit operation_function(scheduler_operation* op) : op_(op) {}
+  operation_function(operation_function&& other) : op_(other.op_) { other.op_ = 0; }
+  ~operation_function()
+  {
+    if (op_) {
+      op_->destroy();
+    }
+  }
+
+  void operator()()
+  {
+    scheduler_operation* op = op_;
+    op_ = 0;
+    op->complete(this, std::error_code(), 0);
+  }
+
+ private:
+  scheduler_operation* op_;
+};
+}  // namespace detail
+
+// ִ̬ ָСִ(io_context::executor_typestrand<io_context::executor_type>)ֱӴڶ
+// post/dispatch/deferֻһexecutor_opֱӵñװִĿͬ
+class any_executor
+{
+ public:
+  enum
+  {
+    inline_size = 2 * sizeof(void*)
+  };
+
+  // ŵƶ쳣ʱڶڣϵĸ
+  template <typename Executor>
+  static constexpr bool stores_inline = sizeof(Executor) <= inline_size && alignof(Executor) <= alignof(void*) &&
+                                        std::is_nothrow_move_constructible<Executor>::value;
+
+  any_executor() : vtable_(0) {}
+  any_executor(std::nullptr_t) : vtable_(0) {}
+
+  template <typename Executor,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<Executor>::type, any_executor>::value>::type>
+  any_executor(Executor e) : vtable_(&vtable_for<Executor>::value)
+  {
+    holder<Executor>::construct(storage_, std::move(e));
+  }
+
+  any_executor(const any_executor& other) : vtable_(other.vtable_)
+  {
+    if (vtable_) {
+      vtable_->copy(storage_, other.storage_);
+    }
+  }
+
+  any_executor(any_executor&& other) : vtable_(other.vtable_)
+  {
+    if (vtable_) {
+      vtable_->move(storage_, other.storage_);
+      other.vtable_ = 0;
+    }
+  }
+
+  ~any_executor() { reset(); }
+
+  any_executor& operator=(const any_executor& other)
+  {
+    if (this != &other) {
+      any_executor tmp(other);
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+
+  any_executor& operator=(any_executor&& other)
+  {
+    if (this != &other) {
+      reset();
+      vtable_ = other.vtable_;
+      if (vtable_) {
+        vtable_->move(storage_, other.storage_);
+        other.vtable_ = 0;
+      }
+    }
+    return *this;
+  }
+
+  any_executor& operator=(std::nullptr_t)
+  {
+    reset();
+    return *this;
+  }
+
+  execution_context& context() const { return get_vtable()->context(storage_); }
+  void on_work_started() const { get_vtable()->on_work_started(storage_); }
+  void on_work_finished() const { get_vtable()->on_work_finished(storage_); }
+  bool running_in_this_thread() const { return get_vtable()->running_in_this_thread(storage_); }
+
+  // ִʱֱӵã
+  template <typename Function, typename Alloc>
+  void dispatch(Function&& func, const Alloc& a) const
+  {
+    const vtable* vt = get_vtable();
+    if (vt->running_in_this_thread(storage_)) {
+      typename std::decay<Function>::type tmp(std::forward<Function>(func));
+      detail::fenced_block b(detail::fenced_block::full);
+      std::invoke(tmp);
+      return;
+    }
+    vt->dispatch(storage_, make_operation(std::forward<Function>(func), a));
+  }
+
+  template <typename Function, typename Alloc>
+  void post(Function&& func, const Alloc& a) const
+  {
+    const vtable* vt = get_vtable();
+    vt->post(storage_, make_operation(std::forward<Function>(func), a), false);
+  }
+
+  template <typename Function, typename Alloc>
+  void defer(Function&& func, const Alloc& a) const
+  {
+    const vtable* vt = get_vtable();
+    vt->post(storage_, make_operation(std::forward<Function>(func), a), true);
+  }
+
+  explicit operator bool() const { return vtable_ != 0; }
+
+  const std::type_info& target_type() const { return vtable_ ? vtable_->type() : typeid(void); }
+
+  template <typename Executor>
+  Executor* target()
+  {
+    return vtable_ == &vtable_for<Executor>::value ? &holder<Executor>::get(storage_) : 0;
+  }
+
+  template <typename Executor>
+  const Executor* target() const
+  {
+    return vtable_ == &vtable_for<Executor>::value ? &holder<Executor>::get(storage_) : 0;
+  }
+
+  friend bool operator==(const any_executor& a, const any_executor& b)
+  {
+    if (a.vtable_ != b.vtable_) {
+      return false;
+    }
+    return !a.vtable_ || a.vtable_->equals(a.storage_, b.storage_);
+  }
+
+  friend bool operator!=(const any_executor& a, const any_executor& b) { return !(a == b); }
+
+ private:
+  struct storage
+  {
+    alignas(void*) unsigned char data_[inline_size];
+  };
+
+  struct vtable
+  {
+    const std::type_info& (*type)();
+    void (*copy)(storage& dst, const storage& src);
+    void (*move)(storage& dst, storage& src);
+    void (*destroy)(storage& s);
+    execution_context& (*context)(const storage& s);
+    void (*on_work_started)(const storage& s);
+    void (*on_work_finished)(const storage& s);
+    bool (*running_in_this_thread)(const storage& s);
+    void (*dispatch)(const storage& s, detail::scheduler_operation* op);
+    void (*post)(const storage& s, detail::scheduler_operation* op, bool is_continuation);
+    bool (*equals)(const storage& a, const storage& b);
+  };
+
+  template <typename Executor, bool Inline = stores_inline<Executor>>
+  struct holder
+  {
+    static Executor& get(storage& s) { return *std::launder(reinterpret_cast<Executor*>(s.data_)); }
+    static const Executor& get(const storage& s) { return *std::launder(reinterpret_cast<const Executor*>(s.data_)); }
+    static void construct(storage& s, Executor&& e) { new (s.data_) Executor(std::move(e)); }
+    static void copy(storage& dst, const storage& src) { new (dst.data_) Executor(get(src)); }
+    static void move(storage& dst, storage& src)
+    {
+      new (dst.data_) Executor(std::move(get(src)));
+      get(src).~Executor();
+    }
+    static void destroy(storage& s) { get(s).~Executor(); }
+  };
+
+  template <typename Executor>
+  struct holder<Executor, false>
+  {
+    static Executor*& ptr(storage& s) { return *reinterpret_cast<Executor**>(s.data_); }
+    static Executor* ptr(const storage& s) { return *reinterpret_cast<Executor* const*>(s.data_); }
+    static Executor& get(storage& s) { return *ptr(s); }
+    static const Executor& get(const storage& s) { return *ptr(s); }
+    static void construct(storage& s, Executor&& e) { ptr(s) = new Executor(std::move(e)); }
+    static void copy(storage& dst, const storage& src) { ptr(dst) = new Executor(get(src)); }
+    static void move(storage& dst, storage& src)
+    {
+      ptr(dst) = ptr(src);
+      ptr(src) = 0;
+    }
+    static void destroy(storage& s) { delete ptr(s); }
+  };
+
+  template <typename Executor>
+  struct functions
+  {
+    using traits = detail::executor_operation_traits<Executor>;
+    using h = holder<Executor>;
+
+    static const std::type_info& type() { return typeid(Executor); }
+    static execution_context& context(const storage& s) { return h::get(s).context(); }
+    static void on_work_started(const storage& s) { h::get(s).on_work_started(); }
+    static void on_work_finished(const storage& s) { h::get(s).on_work_finished(); }
+    static bool equals(const storage& a, const storage& b) { return h::get(a) == h::get(b); }
+
+    static bool running_in_this_thread(const storage& s)
+    {
+      if constexpr (traits::is_specialized) {
+        return traits::running_in_this_thread(h::get(s));
+      } else {
+        (void)s;
+        return false;
+      }
+    }
+
+    static void dispatch(const storage& s, detail::scheduler_operation* op)
+    {
+      if constexpr (traits::is_specialized) {
+        traits::post(h::get(s), op, false);
+      } else {
+        Executor ex(h::get(s));
+        ex.dispatch(detail::operation_function(op), std::allocator<void>());
+      }
+    }
+
+    static void post(const storage& s, detail::scheduler_operation* op, bool is_continuation)
+    {
+      if constexpr (traits::is_specialized) {
+        traits::post(h::get(s), op, is_continuation);
+      } else {
+        Executor ex(h::get(s));
+        if (is_continuation) {
+          ex.defer(detail::operation_function(op), std::allocator<void>());
+        } else {
+          ex.post(detail::operation_function(op), std::allocator<void>());
+        }
+      }
+    }
+  };
+
+  template <typename Executor>
+  struct vtable_for
+  {
+    static const vtable value;
+  };
+
+  template <typename Function, typename Alloc>
+  static detail::scheduler_operation* make_operation(Function&& func, const Alloc& a)
+  {
+    using op = detail::executor_op<typename std::decay<Function>::type, Alloc>;
+    typename op::ptr p = {std::addressof(a), op::ptr::allocate(a), 0};
+    p.p = new (p.v) op(std::forward<Function>(func), a);
+    op* o = p.p;
+    p.v = p.p = 0;
+    return o;
+  }
+
+  const vtable* get_vtable() const
+  {
+    if (!vtable_) {
+      detail::throw_exception(bad_executor());
+    }
+    return vtable_;
+  }
+
+  void reset()
+  {
+    if (vtable_) {
+      vtable_->destroy(storage_);
+      vtable_ = 0;
+    }
+  }
+
+  const vtable* vtable_;
+  mutable storage storage_;
+};
+
+template <typename Executor>
+const any_executor::vtable any_executor::vtable_for<Executor>::value = {
+    &functions<Executor>::type,
+    &holder<Executor>::copy,
+    &holder<Executor>::move,
+    &holder<Executor>::destroy,
+    &functions<Executor>::context,
+    &functions<Executor>::on_work_started,
+    &functions<Executor>::on_work_finished,
+    &functions<Executor>::running_in_this_thread,
+    &functions<Executor>::dispatch,
+    &functions<Executor>::post,
+    &functions<Executor>::equals,
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_ANY_EXECUTOR_HPP
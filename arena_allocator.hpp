@@ -0,0 +1,281 @@
+#ifndef BOOST_ASIO_ARENA_ALLOCATOR_HPP
+#define BOOST_ASIO_ARENA_ALLOCATOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "execution_context.hpp"
+#include "io_context.hpp"
+#include "mutex.hpp"
+#include "service_registry_helpers.hpp"
+#include "thread_info_base.hpp"
+
+namespace boost::asio {
+namespace detail {
+
+// io_contextӵеĴڴ
+// 1Сּthread_cacheһ£ÿ̰߳idɢеһۣӲԼslab˳п飬صĲڴ
+// 2ͷֻѿѹԴ۵ӳٻջʱΪղһȡأͷ·۵
+// 3slabڷʱͳһϵͳschedulerرʱٵĲȻڴ
+class handler_arena : public execution_context_service_base<handler_arena>
+{
+ public:
+  enum
+  {
+    slab_size = 64 * 1024,
+    num_slots = 37
+  };
+
+  explicit handler_arena(execution_context& ctx)
+      : execution_context_service_base<handler_arena>(ctx), heap_allocations_(0)
+  {}
+
+  ~handler_arena()
+  {
+    for (void* slab : slabs_) {
+      ::operator delete(slab);
+    }
+  }
+
+  void shutdown() {}
+
+  void* allocate(std::size_t size)
+  {
+    if (size <= thread_cache::max_class_size) {
+      std::size_t c = thread_cache::size_class(size);
+      std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % num_slots;
+      for (std::size_t i = 0; i < num_slots; ++i) {
+        std::size_t index = (start + i) % num_slots;
+        thread_slot& s = slots_[index];
+        if (!s.busy_.test_and_set(std::memory_order_acquire)) {
+          void* p = allocate(s, index, c);
+          s.busy_.clear(std::memory_order_release);
+          return p;
+        }
+      }
+    }
+    heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+    block_header* h = static_cast<block_header*>(::operator new(sizeof(block_header) + size));
+    h->arena_ = 0;
+    return h + 1;
+  }
+
+  void deallocate(void* pointer)
+  {
+    block_header* h = static_cast<block_header*>(pointer) - 1;
+    if (!h->arena_) {
+      ::operator delete(h);
+      return;
+    }
+    std::atomic<free_block*>& deferred = slots_[h->slot_].deferred_[h->size_class_];
+    free_block* b = static_cast<free_block*>(pointer);
+    free_block* head = deferred.load(std::memory_order_relaxed);
+    do {
+      b->next_ = head;
+    } while (!deferred.compare_exchange_weak(head, b, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  // slabռõֽ
+  std::size_t capacity()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return slabs_.size() * slab_size;
+  }
+
+  // 2KBȫæʱ::operator newĴ
+  std::size_t heap_allocations() const { return heap_allocations_.load(std::memory_order_relaxed); }
+
+ private:
+  struct alignas(alignof(std::max_align_t)) block_header
+  {
+    handler_arena* arena_;  // 0ʾֱӴϵͳ
+    std::uint32_t size_class_;
+    std::uint32_t slot_;
+  };
+
+  // пָû ͷֲ
+  struct free_block
+  {
+    free_block* next_;
+  };
+
+  struct alignas(64) thread_slot
+  {
+    thread_slot() : bump_(0), end_(0)
+    {
+      busy_.clear();
+      for (std::size_t i = 0; i < thread_cache::num_size_classes; ++i) {
+        free_[i] = 0;
+        deferred_[i].store(0, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic_flag busy_;
+    char* bump_;
+    char* end_;
+    free_block* free_[thread_cache::num_size_classes];
+    std::atomic<free_block*> deferred_[thread_cache::num_size_classes];
+  };
+
+  void* allocate(thread_slot& s, std::size_t index, std::size_t c)
+  {
+    free_block* b = s.free_[c];
+    if (!b && s.deferred_[c].load(std::memory_order_relaxed)) {
+      b = s.deferred_[c].exchange(0, std::memory_order_acquire);
+    }
+    if (b) {
+      s.free_[c] = b->next_;
+      return b;
+    }
+
+    std::size_t stride = sizeof(block_header) + (std::size_t(thread_cache::min_class_size) << c);
+    if (static_cast<std::size_t>(s.end_ - s.bump_) < stride) {
+      s.bump_ = static_cast<char*>(new_slab());
+      s.end_ = s.bump_ + slab_size;
+    }
+    block_header* h = reinterpret_cast<block_header*>(s.bump_);
+    s.bump_ += stride;
+    h->arena_ = this;
+    h->size_class_ = static_cast<std::uint32_t>(c);
+    h->slot_ = static_cast<std::uint32_t>(index);
+    return h + 1;
+  }
+
+  // еĩβʣµĲһĿռֱӷ
+  void* new_slab()
+  {
+    void* slab = ::operator new(slab_size);
+    mutex::scoped_lock lock(mutex_);
+    slabs_.push_back(slab);
+    return slab;
+  }
+
+  mutex mutex_;
+  std::vector<void*> slabs_;
+  std::atomic<std::size_t> heap_allocations_;
+  thread_slot slots_[num_slots];
+};
+}  // namespace detail
+
+// io_contextڴط Ϊassociated_allocatorִĬϷ
+template <typename T>
+class arena_allocator
+{
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = arena_allocator<U>;
+  };
+
+  explicit arena_allocator(io_context& ioc) : arena_(&use_service<detail::handler_arena>(ioc)) {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) : arena_(other.arena_)
+  {}
+
+  T* allocate(std::size_t n) { return static_cast<T*>(arena_->allocate(sizeof(T) * n)); }
+  void deallocate(T* p, std::size_t) { arena_->deallocate(p); }
+
+  friend bool operator==(const arena_allocator& a, const arena_allocator& b) { return a.arena_ == b.arena_; }
+  friend bool operator!=(const arena_allocator& a, const arena_allocator& b) { return a.arena_ != b.arena_; }
+
+ private:
+  template <typename U>
+  friend class arena_allocator;
+  detail::handler_arena* arena_;
+};
+
+namespace detail {
+
+// arena_allocator
+template <typename Handler>
+class arena_handler
+{
+ public:
+  using allocator_type = arena_allocator<void>;
+
+  template <typename H>
+  arena_handler(io_context& ioc, H&& handler) : alloc_(ioc), handler_(std::forward<H>(handler))
+  {}
+
+  allocator_type get_allocator() const { return alloc_; }
+
+  template <typename... Args>
+  auto operator()(Args&&... args) -> decltype(std::declval<Handler&>()(std::forward<Args>(args)...))
+  {
+    return handler_(std::forward<Args>(args)...);
+  }
+
+ private:
+  allocator_type alloc_;
+  Handler handler_;
+};
+}  // namespace detail
+
+// Ĳiocڴط
+template <typename Handler>
+inline detail::arena_handler<std::decay_t<Handler>> bind_arena(io_context& ioc, Handler&& handler)
+{
+  return detail::arena_handler<std::decay_t<Handler>>(ioc, std::forward<Handler>(handler));
+}
+
+// Ĭϴڴطio_contextִ
+// ÷std::allocatorʱarena_allocatorԴķֲ
+class arena_executor
+{
+ public:
+  explicit arena_executor(const io_context::executor_type& ex) : ex_(ex), alloc_(ex.context()) {}
+
+  io_context& context() const { return ex_.context(); }
+  void on_work_started() const { ex_.on_work_started(); }
+  void on_work_finished() const { ex_.on_work_finished(); }
+
+  template <typename Function, typename Alloc>
+  void dispatch(Function&& f, const Alloc& a) const
+  {
+    ex_.dispatch(std::forward<Function>(f), select(a));
+  }
+
+  template <typename Function, typename Alloc>
+  void post(Function&& f, const Alloc& a) const
+  {
+    ex_.post(std::forward<Function>(f), select(a));
+  }
+
+  template <typename Function, typename Alloc>
+  void defer(Function&& f, const Alloc& a) const
+  {
+    ex_.defer(std::forward<Function>(f), select(a));
+  }
+
+  bool running_in_this_thread() const { return ex_.running_in_this_thread(); }
+  const io_context::executor_type& inner_executor() const { return ex_; }
+
+  friend bool operator==(const arena_executor& a, const arena_executor& b) { return a.ex_ == b.ex_; }
+  friend bool operator!=(const arena_executor& a, const arena_executor& b) { return a.ex_ != b.ex_; }
+
+ private:
+  template <typename Alloc>
+  const Alloc& select(const Alloc& a) const
+  {
+    return a;
+  }
+
+  template <typename T>
+  const arena_allocator<void>& select(const std::allocator<T>&) const
+  {
+    return alloc_;
+  }
+
+  io_context::executor_type ex_;
+  arena_allocator<void> alloc_;
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_ARENA_ALLOCATOR_HPP
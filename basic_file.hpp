@@ -0,0 +1,103 @@
+#ifndef BOOST_ASIO_BASIC_FILE_HPP
+#define BOOST_ASIO_BASIC_FILE_HPP
+
+#include <cstdint>
+#include <string>
+#include "basic_io_object.hpp"
+#include "file_base.hpp"
+#include "file_service.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+
+// random_access_filestream_fileĹ
+class basic_file : public basic_io_object<detail::file_service>, public file_base
+{
+ public:
+  using native_handle_type = detail::file_service::native_handle_type;
+
+  void open(const std::string& path, flags open_flags)
+  {
+    std::error_code ec;
+    this->get_service().open(this->get_impl(), path.c_str(), open_flags, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void open(const std::string& path, flags open_flags, std::error_code& ec)
+  {
+    this->get_service().open(this->get_impl(), path.c_str(), open_flags, ec);
+  }
+
+  void assign(const native_handle_type& descriptor)
+  {
+    std::error_code ec;
+    this->get_service().assign(this->get_impl(), descriptor, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  bool is_open() const { return this->get_service().is_open(this->get_impl()); }
+
+  native_handle_type native_handle() const { return this->get_service().native_handle(this->get_impl()); }
+
+  void close()
+  {
+    std::error_code ec;
+    this->get_service().close(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void close(std::error_code& ec) { this->get_service().close(this->get_impl(), ec); }
+
+  native_handle_type release() { return this->get_service().release(this->get_impl()); }
+
+  std::uint64_t size() const
+  {
+    std::error_code ec;
+    std::uint64_t n = this->get_service().size(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  void resize(std::uint64_t n)
+  {
+    std::error_code ec;
+    this->get_service().resize(this->get_impl(), n, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void sync_all()
+  {
+    std::error_code ec;
+    this->get_service().sync_all(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void sync_data()
+  {
+    std::error_code ec;
+    this->get_service().sync_data(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  // posix_fadvise lengthΪ0ʾļĩβ
+  void advise(advice a, std::uint64_t offset = 0, std::uint64_t length = 0)
+  {
+    std::error_code ec;
+    this->get_service().advise(this->get_impl(), a, offset, length, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  // readahead [offset, offset+length)ҳ
+  void readahead(std::uint64_t offset, std::size_t length)
+  {
+    std::error_code ec;
+    this->get_service().readahead(this->get_impl(), offset, length, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+ protected:
+  explicit basic_file(io_context& ioc) : basic_io_object<detail::file_service>(ioc) {}
+  ~basic_file() {}
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_BASIC_FILE_HPP
@@ -0,0 +1,81 @@
+#ifndef BOOST_ASIO_BASIC_PERIODIC_TIMER_HPP
+#define BOOST_ASIO_BASIC_PERIODIC_TIMER_HPP
+
+#include "async_result.hpp"
+#include "basic_io_object.hpp"
+#include "chrono_time_traits.hpp"
+#include "periodic_timer_service.hpp"
+#include "throw_exception.hpp"
+#include "wait_traits.hpp"
+
+namespace boost::asio {
+
+// ڶʱ һasync_start֮󰴹̶ڷصֱcancel
+// ʱ䰴first + k * period㣬صۻƯ
+template <typename Clock, typename WaitTraits = wait_traits<Clock>>
+class basic_periodic_timer
+    : public basic_io_object<detail::periodic_timer_service<detail::chrono_time_traits<Clock, WaitTraits>>>
+{
+  using service_impl_type = detail::periodic_timer_service<detail::chrono_time_traits<Clock, WaitTraits>>;
+
+ public:
+  using executor_type = io_context::executor_type;
+  using clock_type = Clock;
+  using duration = typename clock_type::duration;
+  using time_point = typename clock_type::time_point;
+  using traits_type = WaitTraits;
+  using missed_tick_policy = typename service_impl_type::missed_tick_policy;
+
+  static constexpr missed_tick_policy skip = service_impl_type::skip;
+  static constexpr missed_tick_policy catch_up = service_impl_type::catch_up;
+
+  explicit basic_periodic_timer(io_context& ioc) : basic_io_object<service_impl_type>(ioc) {}
+
+  basic_periodic_timer(io_context& ioc, const duration& period) : basic_io_object<service_impl_type>(ioc)
+  {
+    set_period(period);
+  }
+
+  ~basic_periodic_timer() {}
+
+  executor_type get_executor() { return basic_io_object<service_impl_type>::get_executor(); }
+
+  duration period() const { return this->get_service().period(this->get_impl()); }
+  void set_period(const duration& period) { this->get_service().set_period(this->get_impl(), period); }
+
+  // tickʱϲ(skip)(catch_up) һasync_startЧ
+  missed_tick_policy policy() const { return this->get_service().policy(this->get_impl()); }
+  void set_missed_tick_policy(missed_tick_policy policy) { this->get_service().set_policy(this->get_impl(), policy); }
+
+  bool running() const { return this->get_service().running(this->get_impl()); }
+
+  std::size_t cancel()
+  {
+    std::error_code ec;
+    std::size_t s = this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    return s;
+  }
+
+  // һnow + period handler: void(std::error_code, std::size_t ticks)
+  template <typename TickHandler>
+  typename detail::async_result_helper<TickHandler, void(std::error_code, std::size_t)>::result_type async_start(
+      TickHandler&& handler)
+  {
+    return async_start_at(Clock::now() + period(), std::forward<TickHandler>(handler));
+  }
+
+  // һfirst
+  template <typename TickHandler>
+  typename detail::async_result_helper<TickHandler, void(std::error_code, std::size_t)>::result_type async_start_at(
+      const time_point& first, TickHandler&& handler)
+  {
+    async_completion<TickHandler, void(std::error_code, std::size_t)> init(handler);
+    std::error_code ec;
+    this->get_service().async_start(this->get_impl(), first, init.handler_, ec);
+    if (ec) detail::throw_exception(ec);
+    return init.result_.get();
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_BASIC_PERIODIC_TIMER_HPP
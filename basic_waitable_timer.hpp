@@ -74,7 +74,7 @@ class basic_waitable_timer
   {
     std::error_code ec;
     std::size_t s = this->get_service().cancle(this->get_impl(), ec);
-    detail::throw_exception(ec);
+    if (ec) detail::throw_exception(ec);
     return s;
   }
 
@@ -87,6 +87,14 @@ class basic_waitable_timer
 
   time_point expiry() const { return this->get_service().expiry(this->get_impl()); }
 
+  // Ƴٵڵʱ timer_slack_nsĶʱϲһλ
+  duration slack() const { return this->get_service().slack(this->get_impl()); }
+  void set_slack(const duration& slack) { this->get_service().set_slack(this->get_impl(), slack); }
+
+  // ʱ ֮cancel_timer_groupһȡ
+  std::size_t group() const { return this->get_service().group(this->get_impl()); }
+  void set_group(std::size_t group) { this->get_service().set_group(this->get_impl(), group); }
+
   std::size_t expires_at(const time_point& expiry_time)
   {
     std::error_code ec;
@@ -121,5 +129,17 @@ class basic_waitable_timer
     return init.result_.get();
   }
 };
+
+// ȡio_contextgroupClockʱ ֻһؽһζ
+template <typename Clock, typename WaitTraits = wait_traits<Clock>>
+std::size_t cancel_timer_group(io_context& ioc, std::size_t group)
+{
+  std::error_code ec;
+  std::size_t n =
+      use_service<detail::deadline_timer_service<detail::chrono_time_traits<Clock, WaitTraits>>>(ioc).cancel_group(
+          group, ec);
+  if (ec) detail::throw_exception(ec);
+  return n;
+}
 }  // namespace boost::asio
 #endif  // !BOOST_ASIO_BASIC_WAITABLE_TIMER_HPP
@@ -0,0 +1,114 @@
+#ifndef BOOST_ASIO_BUFFER_HPP
+#define BOOST_ASIO_BUFFER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace boost::asio {
+
+// д ӵڴ
+class mutable_buffer
+{
+ public:
+  mutable_buffer() : data_(0), size_(0) {}
+  mutable_buffer(void* data, std::size_t size) : data_(data), size_(size) {}
+
+  void* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+  // ǰnֽ
+  mutable_buffer& operator+=(std::size_t n)
+  {
+    std::size_t offset = n < size_ ? n : size_;
+    data_ = static_cast<char*>(data_) + offset;
+    size_ -= offset;
+    return *this;
+  }
+
+ private:
+  void* data_;
+  std::size_t size_;
+};
+
+// ֻ ӵڴ
+class const_buffer
+{
+ public:
+  const_buffer() : data_(0), size_(0) {}
+  const_buffer(const void* data, std::size_t size) : data_(data), size_(size) {}
+  const_buffer(const mutable_buffer& b) : data_(b.data()), size_(b.size()) {}
+
+  const void* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+  const_buffer& operator+=(std::size_t n)
+  {
+    std::size_t offset = n < size_ ? n : size_;
+    data_ = static_cast<const char*>(data_) + offset;
+    size_ -= offset;
+    return *this;
+  }
+
+ private:
+  const void* data_;
+  std::size_t size_;
+};
+
+inline mutable_buffer operator+(const mutable_buffer& b, std::size_t n)
+{
+  mutable_buffer tmp(b);
+  tmp += n;
+  return tmp;
+}
+
+inline const_buffer operator+(const const_buffer& b, std::size_t n)
+{
+  const_buffer tmp(b);
+  tmp += n;
+  return tmp;
+}
+
+inline mutable_buffer buffer(const mutable_buffer& b) { return b; }
+inline mutable_buffer buffer(const mutable_buffer& b, std::size_t max_size)
+{
+  return mutable_buffer(b.data(), b.size() < max_size ? b.size() : max_size);
+}
+
+inline const_buffer buffer(const const_buffer& b) { return b; }
+inline const_buffer buffer(const const_buffer& b, std::size_t max_size)
+{
+  return const_buffer(b.data(), b.size() < max_size ? b.size() : max_size);
+}
+
+inline mutable_buffer buffer(void* data, std::size_t size) { return mutable_buffer(data, size); }
+inline const_buffer buffer(const void* data, std::size_t size) { return const_buffer(data, size); }
+
+template <typename T, std::size_t N>
+inline mutable_buffer buffer(T (&data)[N])
+{
+  return mutable_buffer(data, N * sizeof(T));
+}
+
+template <typename T, std::size_t N>
+inline const_buffer buffer(const T (&data)[N])
+{
+  return const_buffer(data, N * sizeof(T));
+}
+
+inline mutable_buffer buffer(std::string& data) { return mutable_buffer(data.size() ? &data[0] : 0, data.size()); }
+inline const_buffer buffer(const std::string& data) { return const_buffer(data.data(), data.size()); }
+
+template <typename T>
+inline mutable_buffer buffer(std::vector<T>& data)
+{
+  return mutable_buffer(data.size() ? &data[0] : 0, data.size() * sizeof(T));
+}
+
+template <typename T>
+inline const_buffer buffer(const std::vector<T>& data)
+{
+  return const_buffer(data.size() ? &data[0] : 0, data.size() * sizeof(T));
+}
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_BUFFER_HPP
@@ -0,0 +1,310 @@
+#ifndef BOOST_ASIO_DETAIL_BUFFER_POOL_HPP
+#define BOOST_ASIO_DETAIL_BUFFER_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include "buffer.hpp"
+#include "execution_context.hpp"
+#include "mutex.hpp"
+#include "noncopyable.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+namespace detail {
+class buffer_pool;
+}
+
+// һü һʱ黹
+class pooled_buffer
+{
+ public:
+  pooled_buffer() : pool_(0), index_(0) {}
+  pooled_buffer(const pooled_buffer& other);
+  pooled_buffer(pooled_buffer&& other) : pool_(other.pool_), index_(other.index_) { other.pool_ = 0; }
+  ~pooled_buffer() { reset(); }
+
+  pooled_buffer& operator=(const pooled_buffer& other);
+  pooled_buffer& operator=(pooled_buffer&& other);
+
+  void* data() const;
+  std::size_t size() const;
+  mutable_buffer buffer() const { return mutable_buffer(data(), size()); }
+  operator mutable_buffer() const { return buffer(); }
+
+  // ڻеı Ϊio_uringעỺbuffer id
+  std::uint32_t index() const { return index_; }
+
+  long use_count() const;
+  explicit operator bool() const { return pool_ != 0; }
+  void reset();
+
+ private:
+  friend class detail::buffer_pool;
+  pooled_buffer(detail::buffer_pool* pool, std::uint32_t index) : pool_(pool), index_(index) {}
+
+  detail::buffer_pool* pool_;
+  std::uint32_t index_;
+};
+
+namespace detail {
+
+// io_contextӵеĹ̶С
+// 1ڴ水slab룬slabзֳɹ̶СĿ飬slabֱٲͷ
+// 2ȫֿǴtagջñűʾABA
+// 3̰߳idɢеۣatomic_flagռֱȫֿ
+class buffer_pool : public execution_context_service_base<buffer_pool>
+{
+ public:
+  enum
+  {
+    default_block_size = 64 * 1024,
+    default_blocks_per_slab = 64,
+    max_slabs = 4096,
+    num_caches = 37,
+    cache_depth = 16
+  };
+
+  explicit buffer_pool(execution_context& ctx, std::size_t block_size = default_block_size,
+                       std::size_t blocks_per_slab = default_blocks_per_slab)
+      : execution_context_service_base<buffer_pool>(ctx),
+        block_size_((block_size + block_align - 1) / block_align * block_align),
+        blocks_per_slab_(blocks_per_slab ? blocks_per_slab : 1),
+        stride_(sizeof(block_header) + block_size_),
+        num_slabs_(0),
+        free_head_(0),
+        free_blocks_(0)
+  {
+    for (std::size_t i = 0; i < max_slabs; ++i) {
+      slabs_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  ~buffer_pool()
+  {
+    std::size_t n = num_slabs_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < n; ++i) {
+      ::operator delete(slabs_[i].load(std::memory_order_relaxed), std::align_val_t(block_align));
+    }
+  }
+
+  void shutdown() {}
+
+  // ȡһп üΪ1
+  pooled_buffer allocate()
+  {
+    std::uint32_t index = 0;
+    if (!cache_pop(index) && !global_pop(index)) {
+      index = grow();
+    }
+    header(index)->ref_count_.store(1, std::memory_order_relaxed);
+    return pooled_buffer(this, index);
+  }
+
+  std::size_t block_size() const { return block_size_; }
+  std::size_t capacity() const { return num_slabs_.load(std::memory_order_acquire) * blocks_per_slab_; }
+  std::size_t free_blocks() const { return free_blocks_.load(std::memory_order_relaxed); }
+
+  // slabڴ עỺʹ
+  std::size_t slab_count() const { return num_slabs_.load(std::memory_order_acquire); }
+  mutable_buffer slab(std::size_t i) const
+  {
+    return mutable_buffer(slabs_[i].load(std::memory_order_acquire), stride_ * blocks_per_slab_);
+  }
+
+ private:
+  friend class boost::asio::pooled_buffer;
+
+  enum
+  {
+    block_align = 64
+  };
+
+  // ͷ 
+  struct alignas(64) block_header
+  {
+    std::atomic<long> ref_count_;
+    std::atomic<std::uint32_t> next_;  // һı+1, 0ʾβ
+  };
+
+  struct alignas(64) cache_slot
+  {
+    cache_slot() : count_(0) { busy_.clear(); }
+    std::atomic_flag busy_;
+    std::uint32_t count_;
+    std::uint32_t items_[cache_depth];
+  };
+
+  block_header* header(std::uint32_t index) const
+  {
+    char* slab = static_cast<char*>(slabs_[index / blocks_per_slab_].load(std::memory_order_acquire));
+    return reinterpret_cast<block_header*>(slab + (index % blocks_per_slab_) * stride_);
+  }
+
+  void* data(std::uint32_t index) const { return header(index) + 1; }
+
+  void add_ref(std::uint32_t index) { header(index)->ref_count_.fetch_add(1, std::memory_order_relaxed); }
+
+  long use_count(std::uint32_t index) const { return header(index)->ref_count_.load(std::memory_order_relaxed); }
+
+  void release(std::uint32_t index)
+  {
+    if (header(index)->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      if (!cache_push(index)) {
+        global_push(index);
+      }
+    }
+  }
+
+  cache_slot& this_thread_cache()
+  {
+    return caches_[std::hash<std::thread::id>()(std::this_thread::get_id()) % num_caches];
+  }
+
+  bool cache_pop(std::uint32_t& index)
+  {
+    cache_slot& c = this_thread_cache();
+    if (c.busy_.test_and_set(std::memory_order_acquire)) {
+      return false;
+    }
+    bool found = c.count_ != 0;
+    if (found) {
+      index = c.items_[--c.count_];
+    }
+    c.busy_.clear(std::memory_order_release);
+    return found;
+  }
+
+  bool cache_push(std::uint32_t index)
+  {
+    cache_slot& c = this_thread_cache();
+    if (c.busy_.test_and_set(std::memory_order_acquire)) {
+      return false;
+    }
+    bool stored = c.count_ != cache_depth;
+    if (stored) {
+      c.items_[c.count_++] = index;
+    }
+    c.busy_.clear(std::memory_order_release);
+    return stored;
+  }
+
+  // ͷ: 32λtag 32λ+1
+  bool global_pop(std::uint32_t& index)
+  {
+    std::uint64_t head = free_head_.load(std::memory_order_acquire);
+    for (;;) {
+      std::uint32_t top = static_cast<std::uint32_t>(head);
+      if (top == 0) {
+        return false;
+      }
+      std::uint32_t next = header(top - 1)->next_.load(std::memory_order_relaxed);
+      std::uint64_t new_head = ((head >> 32) + 1) << 32 | next;
+      if (free_head_.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire)) {
+        free_blocks_.fetch_sub(1, std::memory_order_relaxed);
+        index = top - 1;
+        return true;
+      }
+    }
+  }
+
+  void global_push(std::uint32_t index)
+  {
+    block_header* h = header(index);
+    std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+    std::uint64_t new_head;
+    do {
+      h->next_.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+      new_head = ((head >> 32) + 1) << 32 | (index + 1);
+    } while (!free_head_.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+    free_blocks_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // µslab صһ ȫֿ
+  std::uint32_t grow()
+  {
+    mutex::scoped_lock lock(grow_mutex_);
+    std::uint32_t index = 0;
+    if (global_pop(index)) {  // ڼ߳̿Ѿ
+      return index;
+    }
+
+    std::size_t n = num_slabs_.load(std::memory_order_relaxed);
+    if (n == max_slabs) {
+      detail::throw_exception(std::bad_alloc());
+    }
+    void* slab = ::operator new(stride_ * blocks_per_slab_, std::align_val_t(block_align));
+    slabs_[n].store(slab, std::memory_order_release);
+    num_slabs_.store(n + 1, std::memory_order_release);
+
+    std::uint32_t first = static_cast<std::uint32_t>(n * blocks_per_slab_);
+    for (std::size_t i = blocks_per_slab_ - 1; i > 0; --i) {
+      new (header(first + static_cast<std::uint32_t>(i))) block_header();
+      global_push(first + static_cast<std::uint32_t>(i));
+    }
+    new (header(first)) block_header();
+    return first;
+  }
+
+  const std::size_t block_size_;
+  const std::size_t blocks_per_slab_;
+  const std::size_t stride_;
+
+  detail::mutex grow_mutex_;
+  std::atomic<std::size_t> num_slabs_;
+  std::atomic<void*> slabs_[max_slabs];
+
+  alignas(64) std::atomic<std::uint64_t> free_head_;
+  std::atomic<std::size_t> free_blocks_;
+  cache_slot caches_[num_caches];
+};
+}  // namespace detail
+
+inline pooled_buffer::pooled_buffer(const pooled_buffer& other) : pool_(other.pool_), index_(other.index_)
+{
+  if (pool_) {
+    pool_->add_ref(index_);
+  }
+}
+
+inline pooled_buffer& pooled_buffer::operator=(const pooled_buffer& other)
+{
+  if (this != &other) {
+    if (other.pool_) {
+      other.pool_->add_ref(other.index_);
+    }
+    reset();
+    pool_ = other.pool_;
+    index_ = other.index_;
+  }
+  return *this;
+}
+
+inline pooled_buffer& pooled_buffer::operator=(pooled_buffer&& other)
+{
+  if (this != &other) {
+    reset();
+    pool_ = other.pool_;
+    index_ = other.index_;
+    other.pool_ = 0;
+  }
+  return *this;
+}
+
+inline void* pooled_buffer::data() const { return pool_ ? pool_->data(index_) : 0; }
+
+inline std::size_t pooled_buffer::size() const { return pool_ ? pool_->block_size() : 0; }
+
+inline long pooled_buffer::use_count() const { return pool_ ? pool_->use_count(index_) : 0; }
+
+inline void pooled_buffer::reset()
+{
+  if (pool_) {
+    pool_->release(index_);
+    pool_ = 0;
+  }
+}
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_DETAIL_BUFFER_POOL_HPP
@@ -0,0 +1,53 @@
+#ifndef BOOST_ASIO_DETAIL_CACHED_CLOCK_HPP
+#define BOOST_ASIO_DETAIL_CACHED_CLOCK_HPP
+
+#include "noncopyable.hpp"
+
+namespace boost::asio::detail {
+
+// reactorÿεʱʱʱ仺
+// ͬһ߳ÿʱֻһΣʱеget_ready_timers/wait_durationʱ
+class cached_clock_scope : private noncopyable
+{
+ public:
+  cached_clock_scope()
+  {
+    ++iteration_;
+    active_ = true;
+  }
+
+  ~cached_clock_scope() { active_ = false; }
+
+ private:
+  template <typename Clock>
+  friend class cached_clock;
+
+  static inline thread_local unsigned long iteration_ = 0;
+  static inline thread_local bool active_ = false;
+};
+
+template <typename Clock>
+class cached_clock
+{
+ public:
+  using time_point = typename Clock::time_point;
+
+  // ֱӶʱ
+  static time_point now()
+  {
+    if (!cached_clock_scope::active_) {
+      return Clock::now();
+    }
+    if (iteration_ != cached_clock_scope::iteration_) {
+      iteration_ = cached_clock_scope::iteration_;
+      now_ = Clock::now();
+    }
+    return now_;
+  }
+
+ private:
+  static inline thread_local unsigned long iteration_ = 0;
+  static inline thread_local time_point now_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_CACHED_CLOCK_HPP
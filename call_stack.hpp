@@ -18,7 +18,7 @@ class call_stack
     {
       value_ = reinterpret_cast<unsigned char*>(this);
       next_ = call_stack<Key, Value>::top_;
-      call_stack<Key, Value>::top = this;
+      call_stack<Key, Value>::top_ = this;
     }
 
     // ʱ(k,v)ջ
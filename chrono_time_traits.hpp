@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <numeric>
+#include "cached_clock.hpp"
 #include "wait_traits.hpp"
 
 namespace boost::asio::detail {
@@ -15,7 +16,8 @@ struct chrono_time_traits
   using duration = typename clock_type::duration;
   using time_point = typename clock_type::time_point;
 
-  static time_point now() { return clock_type::now(); }
+  // reactorʱڼʱ
+  static time_point now() { return cached_clock<Clock>::now(); }
 
   static time_point add(const time_point& t, const duration& d)
   {
@@ -0,0 +1,58 @@
+#ifndef BOOST_ASIO_COARSE_STEADY_CLOCK_HPP
+#define BOOST_ASIO_COARSE_STEADY_CLOCK_HPP
+
+#include <time.h>
+#include <chrono>
+#include "wait_traits.hpp"
+
+namespace boost::asio {
+
+// CLOCK_MONOTONIC_COARSE vdsoһʱжϵʱ䣬Ӳ
+// ֱΪһjiffy(ͨ1~4ms)ʺֻҪ뾫ȵĶʱ
+struct coarse_steady_clock
+{
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<coarse_steady_clock>;
+
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept
+  {
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+  }
+
+  static duration resolution() noexcept
+  {
+    static const duration res = [] {
+      timespec ts;
+      ::clock_getres(CLOCK_MONOTONIC_COARSE, &ts);
+      return duration(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+    }();
+    return res;
+  }
+};
+
+// ʱʵʱһֱʣȴʱһֱʣʱʱѾ߹ʱ
+template <>
+struct wait_traits<coarse_steady_clock>
+{
+  using clock_type = coarse_steady_clock;
+  using duration = clock_type::duration;
+  using time_point = clock_type::time_point;
+
+  static duration to_wait_duration(const duration& d)
+  {
+    if (d <= duration::zero() || duration::max() - clock_type::resolution() < d) {
+      return d;
+    }
+    return d + clock_type::resolution();
+  }
+
+  static duration to_wait_duration(const time_point& t) { return to_wait_duration(t - clock_type::now()); }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_COARSE_STEADY_CLOCK_HPP
@@ -0,0 +1,13 @@
+#ifndef BOOST_ASIO_COARSE_STEADY_TIMER_HPP
+#define BOOST_ASIO_COARSE_STEADY_TIMER_HPP
+
+#include "basic_periodic_timer.hpp"
+#include "basic_waitable_timer.hpp"
+#include "coarse_steady_clock.hpp"
+
+namespace boost::asio {
+using coarse_steady_timer = basic_waitable_timer<coarse_steady_clock>;
+using coarse_periodic_timer = basic_periodic_timer<coarse_steady_clock>;
+}
+
+#endif  // !BOOST_ASIO_COARSE_STEADY_TIMER_HPP
@@ -14,4 +14,10 @@
 
 #if !defined(BOOST_ASIO_SMALL_BLOCK_RECYCLING)
 #define BOOST_ASIO_SMALL_BLOCK_RECYCLING
+#endif
+
+#if !defined(BOOST_ASIO_HAS_IO_URING) && !defined(BOOST_ASIO_DISABLE_IO_URING)
+#if __has_include(<linux/io_uring.h>)
+#define BOOST_ASIO_HAS_IO_URING
+#endif
 #endif
\ No newline at end of file
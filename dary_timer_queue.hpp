@@ -0,0 +1,331 @@
+#ifndef BOOST_ASIO_DETAIL_DARY_TIMER_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_DARY_TIMER_QUEUE_HPP
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include "error_code.hpp"
+#include "timer_queue_base.hpp"
+#include "wait_op.hpp"
+
+namespace boost::asio::detail {
+
+// dСѶʱ ӿtimer_queueͬ
+// 1ʱ㵥Ųж룬ͬһڵArityӽڵͬһ(8ֽʱ, Arity=864ֽ)
+// 2per_timer_dataָһ飬Ƚʱ
+// 3ϸ³ʹÿѨƶÿԪֻдһΣ
+template <typename T, std::size_t Arity = 4>
+class dary_timer_queue : public timer_queue_base
+{
+  static_assert(Arity >= 2 && (Arity & (Arity - 1)) == 0, "Arity must be a power of two");
+
+ public:
+  using time_point = typename T::time_point;  // ʱ
+  using duration = typename T::duration;      // ʱ
+
+  // ʱ
+  class per_timer_data
+  {
+   public:
+    per_timer_data() : heap_index_(std::numeric_limits<std::size_t>::max()), group_(0), next_(0), prev_(0) {}
+
+    //  0ʾκη
+    std::size_t group() const { return group_; }
+    void set_group(std::size_t group) { group_ = group; }
+
+   private:
+    friend class dary_timer_queue;
+
+    op_queue<wait_op> op_queue_;  // ʱwait_op
+    std::size_t heap_index_;      // ʱڶеid
+    std::size_t group_;
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  dary_timer_queue() : timers_(0), keys_(0), heap_(0), size_(0), capacity_(0) {}
+
+  ~dary_timer_queue()
+  {
+    ::operator delete(keys_, std::align_val_t(cache_line_size));
+    delete[] heap_;
+  }
+
+  // ʱӵ
+  bool enqueue_timer(const time_point& time, per_timer_data& timer, wait_op* op)
+  {
+    if ((timer.prev_ == 0) && (&timer != timers_)) {
+      if (time == time_point::max()) {
+        // ڵļʱҪκζindex
+        timer.heap_index_ = std::numeric_limits<std::size_t>::max();
+      } else {
+        if (size_ == capacity_) {
+          grow();
+        }
+        new (&key(size_)) time_point(time);
+        heap_[size_] = &timer;
+        timer.heap_index_ = size_++;
+        up_heap(timer.heap_index_);
+      }
+
+      timer.next_ = timers_;
+      timer.prev_ = 0;
+      if (timers_) {
+        timers_->prev_ = &timer;
+      }
+      timers_ = &timer;
+    }
+    timer.op_queue_.push(op);
+    return timer.heap_index_ == 0 && timer.op_queue_.front() == op;
+  }
+
+  virtual bool empty() const { return timers_ == 0; }
+
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    if (size_ == 0) {
+      return max_duration;
+    }
+    return this->to_msec(T::to_chrono_duration(T::subtract(key(0), T::now())), max_duration);
+  }
+
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    if (size_ == 0) {
+      return max_duration;
+    }
+    return this->to_usec(T::to_chrono_duration(T::subtract(key(0), T::now())), max_duration);
+  }
+
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (size_ != 0) {
+      const time_point now = T::now();
+      this->record_size(size_);
+      while (size_ != 0 && !T::less_than(now, key(0))) {
+        per_timer_data* timer = heap_[0];
+        this->record_ready(timer->op_queue_,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(T::subtract(now, key(0))));
+        ops.push(timer->op_queue_);
+        remove_timer(*timer);
+      }
+    }
+  }
+
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    while (timers_) {
+      per_timer_data* timer = timers_;
+      timers_ = timers_->next_;
+      ops.push(timer->op_queue_);
+      timer->heap_index_ = std::numeric_limits<std::size_t>::max();
+      timer->next_ = 0;
+      timer->prev_ = 0;
+    }
+    size_ = 0;
+  }
+
+  // ȡʱ
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+                           std::size_t max_cancelled = std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.prev_ != 0 || &timer == timers_) {
+      while (wait_op* op = (num_cancelled != max_cancelled) ? timer.op_queue_.front() : 0) {
+        op->ec_ = error_code::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty()) {
+        remove_timer(timer);
+      }
+    }
+    return num_cancelled;
+  }
+
+  // ȡgroupеĶʱ һؽһζ
+  std::size_t cancel_group(std::size_t group, op_queue<operation>& ops)
+  {
+    std::size_t num_cancelled = 0;
+    bool rebuild = false;
+    per_timer_data* timer = timers_;
+    while (timer) {
+      per_timer_data* next = timer->next_;
+      if (timer->group_ == group) {
+        num_cancelled += this->abort_ops(timer->op_queue_, ops);
+        if (timer->heap_index_ < size_) {
+          heap_[timer->heap_index_] = 0;
+          rebuild = true;
+        }
+        timer->heap_index_ = std::numeric_limits<std::size_t>::max();
+        unlink_timer(*timer);
+      }
+      timer = next;
+    }
+    if (rebuild) {
+      rebuild_heap();
+    }
+    return num_cancelled;
+  }
+
+  // ƶʱ targetԭеĲѾȡ
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    target.op_queue_.push(source.op_queue_);
+    target.heap_index_ = source.heap_index_;
+    source.heap_index_ = std::numeric_limits<std::size_t>::max();
+    if (target.heap_index_ < size_) {
+      heap_[target.heap_index_] = &target;
+    }
+
+    if (timers_ == &source) {
+      timers_ = &target;
+    }
+    if (source.prev_) {
+      source.prev_->next_ = &target;
+    }
+    if (source.next_) {
+      source.next_->prev_ = &target;
+    }
+    target.next_ = source.next_;
+    target.prev_ = source.prev_;
+    source.next_ = 0;
+    source.prev_ = 0;
+  }
+
+ private:
+  enum
+  {
+    cache_line_size = 64,
+    // ڵiʱkeys_[i + offset]ӽڵArity*i+1...Arityʼ
+    offset = Arity - 1
+  };
+
+  time_point& key(std::size_t index) { return keys_[index + offset]; }
+  const time_point& key(std::size_t index) const { return keys_[index + offset]; }
+
+  void set(std::size_t index, const time_point& time, per_timer_data* timer)
+  {
+    key(index) = time;
+    heap_[index] = timer;
+    timer->heap_index_ = index;
+  }
+
+  void up_heap(std::size_t index)
+  {
+    const time_point time = key(index);
+    per_timer_data* timer = heap_[index];
+    while (index > 0) {
+      std::size_t parent = (index - 1) / Arity;
+      if (!T::less_than(time, key(parent))) {
+        break;
+      }
+      set(index, key(parent), heap_[parent]);
+      index = parent;
+    }
+    set(index, time, timer);
+  }
+
+  void down_heap(std::size_t index)
+  {
+    const time_point time = key(index);
+    per_timer_data* timer = heap_[index];
+    for (;;) {
+      std::size_t first = index * Arity + 1;
+      if (first >= size_) {
+        break;
+      }
+      std::size_t last = first + Arity < size_ ? first + Arity : size_;
+      std::size_t min_child = first;
+      for (std::size_t child = first + 1; child < last; ++child) {
+        if (T::less_than(key(child), key(min_child))) {
+          min_child = child;
+        }
+      }
+      if (!T::less_than(key(min_child), time)) {
+        break;
+      }
+      set(index, key(min_child), heap_[min_child]);
+      index = min_child;
+    }
+    set(index, time, timer);
+  }
+
+  void remove_timer(per_timer_data& timer)
+  {
+    std::size_t index = timer.heap_index_;
+    if (index < size_) {
+      timer.heap_index_ = std::numeric_limits<std::size_t>::max();
+      std::size_t last = --size_;
+      if (index != last) {
+        // βԪλµ
+        set(index, key(last), heap_[last]);
+        if (index > 0 && T::less_than(key(index), key((index - 1) / Arity))) {
+          up_heap(index);
+        } else {
+          down_heap(index);
+        }
+      }
+    }
+    unlink_timer(timer);
+  }
+
+  void unlink_timer(per_timer_data& timer)
+  {
+    if (timers_ == &timer) {
+      timers_ = timers_->next_;
+    }
+    if (timer.prev_) {
+      timer.prev_->next_ = timer.next_;
+    }
+    if (timer.next_) {
+      timer.next_->prev_ = timer.prev_;
+    }
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // ȥѾɾ ԵϽ
+  void rebuild_heap()
+  {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (heap_[i]) {
+        set(n++, key(i), heap_[i]);
+      }
+    }
+    size_ = n;
+    for (std::size_t i = n > 1 ? (n - 2) / Arity + 1 : 0; i-- > 0;) {
+      down_heap(i);
+    }
+  }
+
+  //  ʱ鰴ж
+  void grow()
+  {
+    std::size_t capacity = capacity_ ? capacity_ * 2 : 64;
+    // ȷunique_ptr һη׳쳣ʱͷţбԭ
+    std::unique_ptr<per_timer_data*[]> heap(new per_timer_data*[capacity]);
+    time_point* keys = static_cast<time_point*>(
+        ::operator new((capacity + offset) * sizeof(time_point), std::align_val_t(cache_line_size)));
+    if (size_) {
+      std::memcpy(static_cast<void*>(keys + offset), keys_ + offset, size_ * sizeof(time_point));
+      std::memcpy(heap.get(), heap_, size_ * sizeof(per_timer_data*));
+    }
+    ::operator delete(keys_, std::align_val_t(cache_line_size));
+    delete[] heap_;
+    keys_ = keys;
+    heap_ = heap.release();
+    capacity_ = capacity;
+  }
+
+  per_timer_data* timers_;  // ʱ洢
+  time_point* keys_;        // еʱ
+  per_timer_data** heap_;   // еĶʱ keys_±һ
+  std::size_t size_;
+  std::size_t capacity_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_DARY_TIMER_QUEUE_HPP
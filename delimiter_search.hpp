@@ -0,0 +1,130 @@
+#ifndef BOOST_ASIO_DETAIL_DELIMITER_SEARCH_HPP
+#define BOOST_ASIO_DETAIL_DELIMITER_SEARCH_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BOOST_ASIO_HAS_SIMD_DELIMITER_SEARCH
+#endif
+
+// ָ ֽںͶ̵Ķֽڷָ ʱѡAVX2/SSE2/ʵ
+// صһƥʼλ Ҳlast
+namespace boost::asio::detail {
+
+inline const char* find_delimiter_scalar(const char* first, const char* last, const char* delim, std::size_t n)
+{
+  if (n == 0) {
+    return first;
+  }
+  while (static_cast<std::size_t>(last - first) >= n) {
+    const void* p = std::memchr(first, delim[0], (last - first) - n + 1);
+    if (!p) {
+      break;
+    }
+    first = static_cast<const char*>(p);
+    if (std::memcmp(first + 1, delim + 1, n - 1) == 0) {
+      return first;
+    }
+    ++first;
+  }
+  return last;
+}
+
+#if defined(BOOST_ASIO_HAS_SIMD_DELIMITER_SEARCH)
+
+// ѡλmaskУмֽ
+inline const char* verify_candidates(const char* p, unsigned int mask, const char* delim, std::size_t n)
+{
+  while (mask) {
+    const char* candidate = p + __builtin_ctz(mask);
+    if (n <= 2 || std::memcmp(candidate + 1, delim + 1, n - 2) == 0) {
+      return candidate;
+    }
+    mask &= mask - 1;
+  }
+  return 0;
+}
+
+__attribute__((target("sse2"))) inline const char* find_delimiter_sse2(const char* first, const char* last,
+                                                                        const char* delim, std::size_t n)
+{
+  const __m128i head = _mm_set1_epi8(delim[0]);
+  if (n == 1) {
+    for (; last - first >= 16; first += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, head));
+      if (mask) {
+        return first + __builtin_ctz(mask);
+      }
+    }
+  } else {
+    // ͬʱȽֽںβֽ ߶еλУ
+    const __m128i tail = _mm_set1_epi8(delim[n - 1]);
+    for (; static_cast<std::size_t>(last - first) >= n - 1 + 16; first += 16) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + n - 1));
+      unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, head), _mm_cmpeq_epi8(b, tail)));
+      if (const char* p = verify_candidates(first, mask, delim, n)) {
+        return p;
+      }
+    }
+  }
+  return find_delimiter_scalar(first, last, delim, n);
+}
+
+__attribute__((target("avx2"))) inline const char* find_delimiter_avx2(const char* first, const char* last,
+                                                                        const char* delim, std::size_t n)
+{
+  const __m256i head = _mm256_set1_epi8(delim[0]);
+  if (n == 1) {
+    for (; last - first >= 32; first += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, head));
+      if (mask) {
+        return first + __builtin_ctz(mask);
+      }
+    }
+  } else {
+    const __m256i tail = _mm256_set1_epi8(delim[n - 1]);
+    for (; static_cast<std::size_t>(last - first) >= n - 1 + 32; first += 32) {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + n - 1));
+      unsigned int mask =
+          _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, head), _mm256_cmpeq_epi8(b, tail)));
+      if (const char* p = verify_candidates(first, mask, delim, n)) {
+        return p;
+      }
+    }
+  }
+  return find_delimiter_sse2(first, last, delim, n);
+}
+#endif  // !BOOST_ASIO_HAS_SIMD_DELIMITER_SEARCH
+
+inline const char* find_delimiter(const char* first, const char* last, const char* delim, std::size_t n)
+{
+  if (n == 0) {
+    return first;
+  }
+#if defined(BOOST_ASIO_HAS_SIMD_DELIMITER_SEARCH)
+  enum
+  {
+    level_scalar,
+    level_sse2,
+    level_avx2
+  };
+  static const int level = __builtin_cpu_supports("avx2")   ? level_avx2
+                           : __builtin_cpu_supports("sse2") ? level_sse2
+                                                            : level_scalar;
+  if (level == level_avx2) {
+    return find_delimiter_avx2(first, last, delim, n);
+  }
+  if (level == level_sse2) {
+    return find_delimiter_sse2(first, last, delim, n);
+  }
+#endif  // !BOOST_ASIO_HAS_SIMD_DELIMITER_SEARCH
+  return find_delimiter_scalar(first, last, delim, n);
+}
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_DELIMITER_SEARCH_HPP
@@ -0,0 +1,143 @@
+#ifndef BOOST_ASIO_DETAIL_DESCRIPTOR_OPS_HPP
+#define BOOST_ASIO_DETAIL_DESCRIPTOR_OPS_HPP
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <system_error>
+#include "buffer.hpp"
+#include "error_code.hpp"
+
+// ļϵͳ÷װ ͨstd::error_code
+namespace boost::asio::detail::descriptor_ops {
+
+inline std::error_code last_error() { return std::error_code(errno, std::generic_category()); }
+
+inline int close(int d, std::error_code& ec)
+{
+  int result = 0;
+  if (d != -1) {
+    result = ::close(d);
+    if (result != 0 && errno == EINTR) {  // linuxcloseźŴʱѾر
+      result = 0;
+    }
+  }
+  ec = result == 0 ? std::error_code() : last_error();
+  return result;
+}
+
+inline bool set_non_blocking(int d, bool value, std::error_code& ec)
+{
+  int flags = ::fcntl(d, F_GETFL, 0);
+  if (flags < 0) {
+    ec = last_error();
+    return false;
+  }
+  flags = value ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+  if (::fcntl(d, F_SETFL, flags) < 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool would_block(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+
+//  falseʾҪȴɶ
+inline bool non_blocking_read(int d, const mutable_buffer& b, std::error_code& ec, std::size_t& bytes_transferred)
+{
+  for (;;) {
+    ssize_t n = ::read(d, b.data(), b.size());
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && would_block(errno)) {
+      return false;
+    }
+    if (n < 0) {
+      ec = last_error();
+      bytes_transferred = 0;
+    } else {
+      ec = (n == 0 && b.size() != 0) ? make_error_code(error_code::eof) : std::error_code();
+      bytes_transferred = n;
+    }
+    return true;
+  }
+}
+
+// д falseʾҪȴд
+inline bool non_blocking_write(int d, const const_buffer& b, std::error_code& ec, std::size_t& bytes_transferred)
+{
+  for (;;) {
+    ssize_t n = ::write(d, b.data(), b.size());
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && would_block(errno)) {
+      return false;
+    }
+    if (n < 0) {
+      ec = last_error();
+      bytes_transferred = 0;
+    } else {
+      ec = std::error_code();
+      bytes_transferred = n;
+    }
+    return true;
+  }
+}
+
+// ȴ events: POLLIN/POLLOUT/POLLPRI
+inline int poll(int d, short events, std::error_code& ec)
+{
+  pollfd fds;
+  fds.fd = d;
+  fds.events = events;
+  fds.revents = 0;
+  int result = ::poll(&fds, 1, -1);
+  ec = (result < 0 && errno != EINTR) ? last_error() : std::error_code();
+  return result;
+}
+
+// ͬ ڲǷģҪȴʱpoll
+inline std::size_t sync_read(int d, const mutable_buffer& b, std::error_code& ec)
+{
+  if (d == -1) {
+    ec = std::error_code(EBADF, std::generic_category());
+    return 0;
+  }
+  if (b.size() == 0) {
+    ec = std::error_code();
+    return 0;
+  }
+  std::size_t bytes_transferred = 0;
+  while (!non_blocking_read(d, b, ec, bytes_transferred)) {
+    if (poll(d, POLLIN, ec) < 0 && ec) {
+      return 0;
+    }
+  }
+  return bytes_transferred;
+}
+
+inline std::size_t sync_write(int d, const const_buffer& b, std::error_code& ec)
+{
+  if (d == -1) {
+    ec = std::error_code(EBADF, std::generic_category());
+    return 0;
+  }
+  if (b.size() == 0) {
+    ec = std::error_code();
+    return 0;
+  }
+  std::size_t bytes_transferred = 0;
+  while (!non_blocking_write(d, b, ec, bytes_transferred)) {
+    if (poll(d, POLLOUT, ec) < 0 && ec) {
+      return 0;
+    }
+  }
+  return bytes_transferred;
+}
+}  // namespace boost::asio::detail::descriptor_ops
+#endif  // !BOOST_ASIO_DETAIL_DESCRIPTOR_OPS_HPP
@@ -0,0 +1,63 @@
+#ifndef BOOST_ASIO_DETAIL_DESCRIPTOR_WRITE_OP_HPP
+#define BOOST_ASIO_DETAIL_DESCRIPTOR_WRITE_OP_HPP
+
+#include <functional>
+#include "descriptor_ops.hpp"
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "reactor_op.hpp"
+
+namespace boost::asio::detail {
+class descriptor_write_op_base : public reactor_op
+{
+ public:
+  descriptor_write_op_base(int descriptor, const const_buffer& buffer, func_type complete_func)
+      : reactor_op(&descriptor_write_op_base::do_perform, complete_func), descriptor_(descriptor), buffer_(buffer)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    descriptor_write_op_base* o(static_cast<descriptor_write_op_base*>(base));
+    return descriptor_ops::non_blocking_write(o->descriptor_, o->buffer_, o->ec_, o->bytes_transferred_) ? done
+                                                                                                         : not_done;
+  }
+
+ private:
+  int descriptor_;
+  const_buffer buffer_;
+};
+
+template <typename Handler>
+class descriptor_write_op : public descriptor_write_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(descriptor_write_op);
+
+  descriptor_write_op(int descriptor, const const_buffer& buffer, Handler& handler)
+      : descriptor_write_op_base(descriptor, buffer, &descriptor_write_op::do_complete), handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    descriptor_write_op* o(static_cast<descriptor_write_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_DESCRIPTOR_WRITE_OP_HPP
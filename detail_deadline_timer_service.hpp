@@ -1,34 +1,73 @@
 #ifndef BOOST_ASIO_DETAIL_DEADLINE_TIMER_SERVICE_HPP
 #define BOOST_ASIO_DETAIL_DEADLINE_TIMER_SERVICE_HPP
 
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <type_traits>
 #include "chrono_time_traits.hpp"
+#include "coarse_steady_clock.hpp"
+#include "dary_timer_queue.hpp"
 #include "epoll_reactor.hpp"
+#include "error_code.hpp"
 #include "io_context.hpp"
+#include "mutex.hpp"
 #include "service_registry_helpers.hpp"
+#include "sharded_timer_queue.hpp"
 #include "timer_queue.hpp"
+#include "timer_queue_traits.hpp"
+#include "timing_wheel.hpp"
 #include "wait_traits.hpp"
 #include "wait_handler.hpp"
 
 namespace boost::asio::detail {
-template <typename Clock>
-class deadline_timer_service : public service_base<deadline_timer_service<Clock>>
+// ʱĬϵĶʱ timer_queue_traits<clock_type>
+template <typename Time_Traits, typename Traits = timer_queue_traits<typename Time_Traits::clock_type>>
+using unsharded_timer_queue = std::conditional_t<
+    Traits::use_timing_wheel, timing_wheel<Time_Traits>,
+    std::conditional_t<Traits::heap_arity == 4 || Traits::heap_arity == 8, dary_timer_queue<Time_Traits, Traits::heap_arity>,
+                       timer_queue<Time_Traits>>>;
+
+template <typename Time_Traits, typename Traits = timer_queue_traits<typename Time_Traits::clock_type>>
+using default_timer_queue =
+    std::conditional_t<(Traits::timer_shards > 1),
+                       sharded_timer_queue<Time_Traits, unsharded_timer_queue<Time_Traits, Traits>,
+                                           (Traits::timer_shards > 1 ? Traits::timer_shards : 1)>,
+                       unsharded_timer_queue<Time_Traits, Traits>>;
+
+// TimerQueueѡtimer_queue()dary_timer_queue(d)timing_wheel(ʱ)sharded_timer_queue(Ƭ)
+template <typename Clock, typename TimerQueue = default_timer_queue<Clock>>
+class deadline_timer_service : public service_base<deadline_timer_service<Clock, TimerQueue>>
 {
  public:
   using time_point = typename Clock::time_point;
   using duration = typename Clock::duration;
   using timer_scheduler = epoll_reactor;
 
+  // ͬwaitϵ߳ implϣcancelʱtimerfdĳ
+  struct sync_waiter
+  {
+    int fd;
+    bool cancelled;
+    sync_waiter* next;
+  };
+
   // 
   struct impl_type : private noncopyable
   {
     time_point expiry;                                       // ʱ
     bool might_have_pending_waits;                           // Ƿڵȴ
-    typename timer_queue<Clock>::per_timer_data timer_data;  // ʱ[id, wait_op, ...]
+    duration slack;                                          // Ƴٵڵʱ
+    typename TimerQueue::per_timer_data timer_data;            // ʱ[id, wait_op, ...]
+    std::atomic<sync_waiter*> sync_waiters;                    // ͬȴ߳
   };
 
   // ʱӵ
   deadline_timer_service(io_context& ioc)
-      : service_base<deadline_timer_service<Clock>>(ioc), scheduler_(use_service<timer_scheduler>(ioc))
+      : service_base<deadline_timer_service<Clock, TimerQueue>>(ioc), scheduler_(use_service<timer_scheduler>(ioc))
   {
     scheduler_.init_task();
     scheduler_.add_timer_queue(timer_queue_);
@@ -44,6 +83,8 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
   {
     impl.expiry = time_point();
     impl.might_have_pending_waits = false;
+    impl.slack = duration::zero();
+    impl.sync_waiters.store(0, std::memory_order_relaxed);
   }
 
   // 
@@ -61,6 +102,8 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
     other_impl.expiry = time_point();
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
+    impl.slack = other_impl.slack;
+    impl.sync_waiters.store(0, std::memory_order_relaxed);
   }
 
   // ƶֵ
@@ -78,16 +121,18 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
     other_impl.expiry = time_point();
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
+    impl.slack = other_impl.slack;
   }
 
   // ȡʱ
   std::size_t cancle(impl_type& impl, std::error_code& ec)
   {
+    std::size_t count = this->cancel_sync_waits(impl);
     if (!impl.might_have_pending_waits) {
       ec = std::error_code();
-      return 0;
+      return count;
     }
-    std::size_t count = scheduler_.cancel_timer(timer_queue_, impl.timer_data);
+    count += scheduler_.cancel_timer(timer_queue_, impl.timer_data);
     impl.might_have_pending_waits = false;
     ec = std::error_code();
     return count;
@@ -108,7 +153,25 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
     return count;
   }
 
+  // ʱ 0ʾκη
+  std::size_t group(const impl_type& impl) const { return impl.timer_data.group(); }
+  void set_group(impl_type& impl, std::size_t group) { impl.timer_data.set_group(group); }
+
+  // ȡgroupжʱ
+  std::size_t cancel_group(std::size_t group, std::error_code& ec)
+  {
+    ec = std::error_code();
+    if (group == 0) {
+      return 0;
+    }
+    return scheduler_.cancel_timer_group(timer_queue_, group);
+  }
+
   time_point expiry(const impl_type& impl) const { return impl.expiry; }
+  duration slack(const impl_type& impl) const { return impl.slack; }
+
+  // ֮async_wait[expiry, expiry + slack]ʱ
+  void set_slack(impl_type& impl, const duration& slack) { impl.slack = slack; }
   time_point expires_at(const impl_type& impl) const { return impl.expiry; }
   duration expires_from_now(const impl_type& impl) const { return Clock::subtract(this->expiry(impl), Clock::now()); }
 
@@ -130,15 +193,66 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
     return this->expires_at(impl, Clock::add(Clock::now(), expiry_time), ec);
   }
 
-  // ͬȴ
+  // ͬȴ ÿεһtimerfdȵexpiry߳cancelʱoperation_aborted
   void wait(impl_type& impl, std::error_code& ec)
   {
-    time_point now = Clock::now();
     ec = std::error_code();
-    while (Clock::less_than(now, impl.expiry) && !ec) { // ڵȴʱ޸implֵԼwhileѭ
-      this->do_wait(Clock::to_chrono_duration(Clock::subtract(impl.expiry, now)), ec);
-      now = Clock::now();
+    time_point expiry = impl.expiry;
+    if (!Clock::less_than(Clock::now(), expiry)) {
+      return;
+    }
+
+    sync_waiter waiter;
+    waiter.fd = ::timerfd_create(sync_wait_clock() == -1 ? CLOCK_MONOTONIC : sync_wait_clock(),
+                                 TFD_CLOEXEC | TFD_NONBLOCK);
+    if (waiter.fd == -1) {
+      ec = std::error_code(errno, std::generic_category());
+      return;
+    }
+    waiter.cancelled = false;
+    {
+      mutex::scoped_lock lock(mutex_);
+      waiter.next = impl.sync_waiters.load(std::memory_order_relaxed);
+      impl.sync_waiters.store(&waiter, std::memory_order_relaxed);
+    }
+
+    for (;;) {
+      time_point now = Clock::now();
+      if (!Clock::less_than(now, expiry)) {
+        break;
+      }
+      {
+        mutex::scoped_lock lock(mutex_);
+        if (waiter.cancelled) {
+          ec = error_code::operation_aborted;
+          break;
+        }
+        arm_sync_wait(waiter.fd, expiry, now);
+      }
+      pollfd pfd = {waiter.fd, POLLIN, 0};
+      if (::poll(&pfd, 1, -1) == -1 && errno != EINTR) {
+        ec = std::error_code(errno, std::generic_category());
+        break;
+      }
+      // timerfd źŻʱûеڣEAGAINֱӺ
+      std::uint64_t expirations;
+      while (::read(waiter.fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+      }
+    }
+
+    {
+      mutex::scoped_lock lock(mutex_);
+      sync_waiter* p = impl.sync_waiters.load(std::memory_order_relaxed);
+      if (p == &waiter) {
+        impl.sync_waiters.store(waiter.next, std::memory_order_relaxed);
+      } else {
+        while (p->next != &waiter) {
+          p = p->next;
+        }
+        p->next = waiter.next;
+      }
     }
+    ::close(waiter.fd);
   }
 
   // 첽ȴ
@@ -150,19 +264,70 @@ class deadline_timer_service : public service_base<deadline_timer_service<Clock>
     p.p = new (p.v) op(handler);
 
     impl.might_have_pending_waits = true;
-    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
+    // slackǴڿ ǵȴʱ䣬ܾwait_traitsʱӷֱ
+    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p,
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(impl.slack));
     p.v = p.p = 0;
   }
 
  private:
-  void do_wait(const duration& timeout, std::error_code& ec)
+  // ͬȴʹõںʱ steady_clockCLOCK_MONOTONICͬ㣬ֱþʱ
+  // coarse_steady_clockCLOCK_MONOTONICһjiffyʱnow()Կڵʱ䣬
+  // ᷴѾȥʱתʱ䣬wait_traitsһֱ
+  static constexpr int sync_wait_clock()
   {
-    std::this_thread::sleep_for(Clock::to_chrono_duration(timeout));
-    ec = std::error_code();
+    using clock_type = typename Clock::clock_type;
+    if (std::is_same<clock_type, std::chrono::steady_clock>::value) {
+      return CLOCK_MONOTONIC;
+    }
+    if (std::is_same<clock_type, std::chrono::system_clock>::value) {
+      return CLOCK_REALTIME;
+    }
+    return -1;
+  }
+
+  // ʱӰʱ waitѭ¼
+  static void arm_sync_wait(int fd, const time_point& expiry, const time_point& now)
+  {
+    itimerspec ts = {{0, 0}, {0, 0}};
+    std::int64_t ns;
+    int flags = 0;
+    if (sync_wait_clock() != -1) {
+      ns = std::chrono::duration_cast<std::chrono::nanoseconds>(expiry.time_since_epoch()).count();
+      flags = TFD_TIMER_ABSTIME;
+    } else {
+      ns = Clock::to_chrono_duration(Clock::subtract(expiry, now)).count();
+    }
+    if (ns <= 0) {
+      ns = 1;
+    }
+    ts.it_value.tv_sec = ns / 1000000000;
+    ts.it_value.tv_nsec = ns % 1000000000;
+    ::timerfd_settime(fd, flags, &ts, 0);
+  }
+
+  // ͬȴ߳
+  std::size_t cancel_sync_waits(impl_type& impl)
+  {
+    if (!impl.sync_waiters.load(std::memory_order_relaxed)) {
+      return 0;
+    }
+    std::size_t count = 0;
+    mutex::scoped_lock lock(mutex_);
+    for (sync_waiter* p = impl.sync_waiters.load(std::memory_order_relaxed); p; p = p->next) {
+      if (!p->cancelled) {
+        p->cancelled = true;
+        itimerspec ts = {{0, 0}, {0, 1}};
+        ::timerfd_settime(p->fd, TFD_TIMER_ABSTIME, &ts, 0);
+        ++count;
+      }
+    }
+    return count;
   }
 
-  timer_queue<Clock> timer_queue_;
+  TimerQueue timer_queue_;
   timer_scheduler& scheduler_;
+  mutex mutex_;  // impl.sync_waiters
 };
 };  // namespace boost::asio::detail
 #endif
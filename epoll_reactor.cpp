@@ -3,6 +3,7 @@
 #include <unistd.h>
 #include <cstddef>
 #include <iostream>
+#include "cached_clock.hpp"
 #include "epoll_reactor.hpp"
 #include "error_code.hpp"
 #include "execution_context.hpp"
@@ -17,7 +18,8 @@ epoll_reactor::epoll_reactor(execution_context& ctx)
       epoll_fd_(do_epoll_create()),
       timer_fd_(do_timerfd_create()),
       shutdown_(false),
-      mutex_(scheduler_.concurrency_hint() == 1),
+      timer_statistics_enabled_(false),
+      mutex_(scheduler_.concurrency_hint() > 1),
       registered_descriptors_mutex_(mutex_.enabled())
 {
   epoll_event ev = {0, {0}};
@@ -58,6 +60,12 @@ void epoll_reactor::shutdown()
     state->shutdown_ = true;
     registered_descriptors_.free(state);
   }
+
+  // ȡжʱ Ƭͬʱرգ֮ĵȴֱ
+  lock.lock();
+  timer_queues_.get_all_timers(ops);
+  lock.unlock();
+  scheduler_.abandon_operations(ops);
 }
 
 void epoll_reactor::init_task() { scheduler_.init_task(); }
@@ -128,7 +136,62 @@ void epoll_reactor::post_immediate_completion(reactor_op* op, bool is_continuati
 
 void epoll_reactor::start_op(int op_type, socket_type descriptor, ptr_descriptor_data& descriptor_data, reactor_op* op,
                              bool is_continuation, bool allow_speculative)
-{}
+{
+  if (!descriptor_data) {
+    op->ec_ = std::error_code(EBADF, std::generic_category());
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock lock(descriptor_data->mutex_);
+  if (descriptor_data->shutdown_) {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (descriptor_data->op_queue_[op_type].empty()) {
+    if (allow_speculative && (op_type != read_op || descriptor_data->op_queue_[except_op].empty())) {
+      // Ϊʱȳֱִ ɹҪȴepoll
+      if (descriptor_data->try_speculative_[op_type]) {
+        if (reactor_op::status status = op->perform()) {
+          if (status == reactor_op::done_and_exhausted && descriptor_data->registered_events_ != 0) {
+            descriptor_data->try_speculative_[op_type] = false;
+          }
+          lock.unlock();
+          scheduler_.post_immediate_completion(op, is_continuation);
+          return;
+        }
+      }
+
+      if (descriptor_data->registered_events_ == 0) {
+        op->ec_ = std::error_code(EOPNOTSUPP, std::generic_category());
+        scheduler_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+    } else if (descriptor_data->registered_events_ == 0) {
+      op->ec_ = std::error_code(EOPNOTSUPP, std::generic_category());
+      scheduler_.post_immediate_completion(op, is_continuation);
+      return;
+    }
+
+    // дһҪȴʱŹעEPOLLOUT
+    if (op_type == write_op && (descriptor_data->registered_events_ & EPOLLOUT) == 0) {
+      epoll_event ev = {0, {0}};
+      ev.events = descriptor_data->registered_events_ | EPOLLOUT;
+      ev.data.ptr = descriptor_data;
+      if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0) {
+        descriptor_data->registered_events_ |= ev.events;
+      } else {
+        op->ec_ = std::error_code(errno, std::generic_category());
+        scheduler_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+    }
+  }
+
+  descriptor_data->op_queue_[op_type].push(op);
+  scheduler_.work_started();
+}
 
 void epoll_reactor::cancel_ops(socket_type, ptr_descriptor_data& descriptor_data)
 {
@@ -255,6 +318,9 @@ void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
   timer_queues_.insert(&queue);
+  if (timer_statistics_enabled_) {
+    queue.enable_statistics();
+  }
 }
 
 void epoll_reactor::do_remove_timer_queue(timer_queue_base& queue)
@@ -263,6 +329,25 @@ void epoll_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void epoll_reactor::enable_timer_statistics()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_statistics_enabled_ = true;
+  timer_queues_.enable_statistics();
+}
+
+void epoll_reactor::timer_statistics(boost::asio::timer_statistics& statistics)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.merge_statistics(statistics);
+}
+
+void epoll_reactor::reset_timer_statistics()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reset_statistics();
+}
+
 void epoll_reactor::update_timeout()
 {
 #if defined(BOOST_ASIO_HAS_TIMERFD)
@@ -315,6 +400,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     timeout = int((usec < 0) ? -1 : ((usec - 1) / 1000 + 1));
     if (timer_fd_ == -1) {
       mutex::scoped_lock lock(mutex_);
+      cached_clock_scope clock_scope;
       timeout = get_timeout(timeout);
     }
   }
@@ -360,6 +446,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 
   if (check_timers) {
     mutex::scoped_lock lock(mutex_);
+    cached_clock_scope clock_scope;  // жеĵڼһγʱһʱӶȡ
     timer_queues_.get_ready_timers(ops);
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
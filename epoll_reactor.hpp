@@ -1,6 +1,8 @@
 #ifndef BOOST_ASIO_DETAIL_EPOLL_REACTOR_HPP
 #define BOOST_ASIO_DETAIL_EPOLL_REACTOR_HPP
 
+#include <chrono>
+#include <cstdint>
 #include "conditionally_enabled_mutex.hpp"
 #include "config.hpp"
 #include "execution_context.hpp"
@@ -10,6 +12,7 @@
 #include "scheduler.hpp"
 #include "scheduler_operation.hpp"
 #include "select_interrupter.hpp"
+#include "sharded_timer_queue.hpp"
 #include "timer_queue_base.hpp"
 #include "timer_queue_set.hpp"
 #include "wait_op.hpp"
@@ -89,21 +92,30 @@ class epoll_reactor : public execution_context_service_base<epoll_reactor>
 
   void interrupt();
 
-  template <typename T>
-  void add_timer_queue(timer_queue<T>& timer_queue)
+  // ʱͳ ֮ӵĶҲ
+  void enable_timer_statistics();
+
+  // жʱкϲͳ
+  void timer_statistics(boost::asio::timer_statistics& statistics);
+  void reset_timer_statistics();
+
+  // QueueΪtimer_queuetiming_wheel
+  template <typename Queue>
+  void add_timer_queue(Queue& timer_queue)
   {
     do_add_timer_queue(timer_queue);
   }
 
-  template <typename T>
-  void remove_timer_queue(timer_queue<T>& timer_queue)
+  template <typename Queue>
+  void remove_timer_queue(Queue& timer_queue)
   {
     do_remove_timer_queue(timer_queue);
   }
 
-  template <typename T>
-  void schedule_timer(timer_queue<T>& queue, const typename T::time_point& time,
-                      typename timer_queue<T>::per_timer_data& timer, wait_op* op)
+  // slackΪƳٵڵʱ Ķʱϲͬһڣı絽ʱʱtimerfd
+  template <typename Queue>
+  void schedule_timer(Queue& queue, const typename Queue::time_point& time, typename Queue::per_timer_data& timer,
+                      wait_op* op, std::chrono::nanoseconds slack = std::chrono::nanoseconds(0))
   {
     mutex::scoped_lock lock(mutex_);
     if (shutdown_) {
@@ -111,15 +123,33 @@ class epoll_reactor : public execution_context_service_base<epoll_reactor>
       return;
     }
 
-    bool earliest = queue.enqueue_timer(time, timer, op);
+    bool earliest = queue.enqueue_timer(apply_slack(time, slack), timer, op);
     scheduler_.work_started();
     if (earliest) {
       update_timeout();
     }
   }
 
-  template <typename T>
-  std::size_t cancel_timer(timer_queue<T>& queue, typename timer_queue<T>::per_timer_data& timer,
+  // ƬʱֻʱڷƬ 絽ʱ仯ʱŽmutex_timerfd
+  template <typename T, typename Queue, std::size_t Shards>
+  void schedule_timer(sharded_timer_queue<T, Queue, Shards>& queue, const typename T::time_point& time,
+                      typename sharded_timer_queue<T, Queue, Shards>::per_timer_data& timer, wait_op* op,
+                      std::chrono::nanoseconds slack = std::chrono::nanoseconds(0))
+  {
+    bool earliest = false;
+    scheduler_.work_started();
+    if (!queue.enqueue_timer(apply_slack(time, slack), timer, op, earliest)) {
+      scheduler_.post_deferred_completion(op);
+      return;
+    }
+    if (earliest) {
+      mutex::scoped_lock lock(mutex_);
+      update_timeout();
+    }
+  }
+
+  template <typename Queue>
+  std::size_t cancel_timer(Queue& queue, typename Queue::per_timer_data& timer,
                            std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
   {
     mutex::scoped_lock lock(mutex_);
@@ -130,18 +160,76 @@ class epoll_reactor : public execution_context_service_base<epoll_reactor>
     return n;
   }
 
-  template <typename T>
-  void move_timer(timer_queue<T>& queue, typename timer_queue<T>::per_timer_data& target,
-                  typename timer_queue<T>::per_timer_data& source)
+  template <typename T, typename Queue, std::size_t Shards>
+  std::size_t cancel_timer(sharded_timer_queue<T, Queue, Shards>& queue,
+                           typename sharded_timer_queue<T, Queue, Shards>::per_timer_data& timer,
+                           std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    op_queue<operation> ops;
+    std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
+    scheduler_.post_deferred_completions(ops);
+    return n;
+  }
+
+  // ȡgroupжʱ ֻһȡĲһͶ
+  template <typename Queue>
+  std::size_t cancel_timer_group(Queue& queue, std::size_t group)
+  {
+    mutex::scoped_lock lock(mutex_);
+    op_queue<operation> ops;
+    std::size_t n = queue.cancel_group(group, ops);
+    lock.unlock();
+    scheduler_.post_deferred_completions(ops);
+    return n;
+  }
+
+  template <typename T, typename Queue, std::size_t Shards>
+  std::size_t cancel_timer_group(sharded_timer_queue<T, Queue, Shards>& queue, std::size_t group)
+  {
+    op_queue<operation> ops;
+    std::size_t n = queue.cancel_group(group, ops);
+    scheduler_.post_deferred_completions(ops);
+    return n;
+  }
+
+  template <typename Queue>
+  void move_timer(Queue& queue, typename Queue::per_timer_data& target, typename Queue::per_timer_data& source)
   {
     mutex::scoped_lock lock(mutex_);
     op_queue<operation> ops;
-    queue.cancle_timer(target, ops);
+    queue.cancel_timer(target, ops);
     queue.move_timer(target, source);
     lock.unlock();
+    scheduler_.post_deferred_completions(ops);
+  }
+
+  template <typename T, typename Queue, std::size_t Shards>
+  void move_timer(sharded_timer_queue<T, Queue, Shards>& queue,
+                  typename sharded_timer_queue<T, Queue, Shards>::per_timer_data& target,
+                  typename sharded_timer_queue<T, Queue, Shards>::per_timer_data& source)
+  {
+    op_queue<operation> ops;
+    queue.cancel_timer(target, ops);
+    queue.move_timer(target, source);
+    scheduler_.post_deferred_completions(ops);
   }
 
  private:
+  // ʱƳٵslack2ݵ ͬһڵĶʱʱͬһλһ
+  template <typename Time_Point>
+  static Time_Point apply_slack(const Time_Point& time, std::chrono::nanoseconds slack)
+  {
+    using duration = typename Time_Point::duration;
+    if (slack.count() <= 0 || time.time_since_epoch().count() < 0 ||
+        time.time_since_epoch() >= std::chrono::duration_cast<duration>(std::chrono::nanoseconds::max() / 2)) {
+      return time;
+    }
+    std::int64_t window = std::int64_t(1) << (63 - __builtin_clzll(static_cast<std::uint64_t>(slack.count())));
+    std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    ns = (ns + window - 1) & ~(window - 1);
+    return Time_Point(std::chrono::ceil<duration>(std::chrono::nanoseconds(ns)));
+  }
+
   static int do_epoll_create();
   static int do_timerfd_create();
   void do_add_timer_queue(timer_queue_base& queue);
@@ -165,6 +253,7 @@ class epoll_reactor : public execution_context_service_base<epoll_reactor>
   timer_queue_set timer_queues_;
 
   bool shutdown_;
+  bool timer_statistics_enabled_;
   mutable mutex mutex_;
   mutable mutex registered_descriptors_mutex_;
   object_pool<descriptor_state> registered_descriptors_;
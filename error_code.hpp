@@ -1,6 +1,7 @@
 #ifndef BOOST_ASIO_DETAIL_ERROR_CODE_HPP
 #define BOOST_ASIO_DETAIL_ERROR_CODE_HPP
 
+#include <string>
 #include <system_error>
 
 namespace boost::asio::detail {
@@ -8,13 +9,42 @@ enum class error_code
 {
   success = 0,
   operation_aborted,
+  eof,
+  not_found,
 };
 
+class error_category : public std::error_category
+{
+ public:
+  const char* name() const noexcept { return "asio.misc"; }
+
+  std::string message(int value) const
+  {
+    switch (static_cast<error_code>(value)) {
+      case error_code::success:
+        return "Success";
+      case error_code::operation_aborted:
+        return "Operation aborted";
+      case error_code::eof:
+        return "End of file";
+      case error_code::not_found:
+        return "Element not found";
+    }
+    return "asio.misc error";
+  }
+};
+
+inline const std::error_category& get_error_category()
+{
+  static const error_category instance;
+  return instance;
+}
+
 inline std::error_code make_error_code(error_code code)
 {
   return {
       static_cast<int>(code),
-      std::generic_category(),
+      get_error_category(),
   };
 }
 }  // namespace boost::asio::detail
@@ -24,4 +54,4 @@ template <>
 struct is_error_code_enum<boost::asio::detail::error_code> : true_type
 {};
 }  // namespace std
-#endif  //! BOOST_ASIO_DETAIL_ERROR_CODE
\ No newline at end of file
+#endif  //! BOOST_ASIO_DETAIL_ERROR_CODE
@@ -69,6 +69,7 @@ class event : private noncopyable
       waiter w(state_);
       cond_.wait(ulock);  // ֱ(state_&1)==1
     }
+    ulock.release();  // ɵߵlock
   }
 
   template <typename Lock>
@@ -76,10 +77,11 @@ class event : private noncopyable
   {
     assert(lock.locked());
     std::unique_lock<std::mutex> ulock(lock.mutex().mutex_, std::adopt_lock);
-    while ((state_ & 1) == 0) {
+    if ((state_ & 1) == 0) {
       waiter w(state_);  // ֱ(state_&1)==1߳ʱ
       cond_.wait_for(ulock, std::chrono::microseconds(usec));
     }
+    ulock.release();
     return (state_ & 1) != 0;
   }
 
@@ -5,6 +5,7 @@
 #include <type_traits>
 #include "fenced_block.hpp"
 #include "handler_alloc_helpers.hpp"
+#include "handler_invoke_helpers.hpp"
 #include "scheduler_operation.hpp"
 
 namespace boost::asio::detail {
@@ -16,7 +17,7 @@ class executor_op : public Operation
 
   template <typename Function>
   executor_op(Function&& func, const Alloc& a)
-      : Operation(&executor_op::do_complete), handler_(std::forward(func)), alloc_(a)
+      : Operation(&executor_op::do_complete), handler_(std::forward<Function>(func)), alloc_(a)
   {
     static_assert(std::is_convertible<Function&, Handler&>::value);
   }
@@ -26,7 +27,7 @@ class executor_op : public Operation
     executor_op* o(static_cast<executor_op*>(base));
     Alloc a(o->alloc_);
     ptr p = {std::addressof(a), o, o};
-    Handler hander(std::move(o->handler_));
+    Handler handler(std::move(o->handler_));
     p.reset();
     if (owner) {
       detail::fenced_block b(detail::fenced_block::half);
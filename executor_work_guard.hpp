@@ -41,6 +41,7 @@ class executor_work_guard
   {
     if (owns_) {
       executor_.on_work_finished();
+      owns_ = false;
     }
   }
 
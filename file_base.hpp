@@ -0,0 +1,49 @@
+#ifndef BOOST_ASIO_FILE_BASE_HPP
+#define BOOST_ASIO_FILE_BASE_HPP
+
+#include <fcntl.h>
+
+namespace boost::asio {
+
+class file_base
+{
+ public:
+  // 򿪷ʽ ԰λ
+  enum flags
+  {
+    read_only = O_RDONLY,
+    write_only = O_WRONLY,
+    read_write = O_RDWR,
+    append = O_APPEND,
+    create = O_CREAT,
+    exclusive = O_EXCL,
+    truncate = O_TRUNC,
+    sync_all_on_write = O_SYNC
+  };
+
+  friend flags operator|(flags a, flags b) { return flags(int(a) | int(b)); }
+  friend flags operator&(flags a, flags b) { return flags(int(a) & int(b)); }
+
+  // posix_fadviseģʽʾ
+  enum advice
+  {
+    advise_normal = POSIX_FADV_NORMAL,
+    advise_sequential = POSIX_FADV_SEQUENTIAL,
+    advise_random = POSIX_FADV_RANDOM,
+    advise_will_need = POSIX_FADV_WILLNEED,
+    advise_dont_need = POSIX_FADV_DONTNEED,
+    advise_no_reuse = POSIX_FADV_NOREUSE
+  };
+
+  enum seek_basis
+  {
+    seek_set = SEEK_SET,
+    seek_cur = SEEK_CUR,
+    seek_end = SEEK_END
+  };
+
+ protected:
+  ~file_base() {}
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_FILE_BASE_HPP
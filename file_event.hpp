@@ -0,0 +1,28 @@
+#ifndef BOOST_ASIO_FILE_EVENT_HPP
+#define BOOST_ASIO_FILE_EVENT_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace boost::asio {
+
+// file_watcherļϵͳ¼
+struct file_event
+{
+  enum type
+  {
+    created,   // ½뱻Ŀ¼
+    modified,  // ޸Ļдر
+    moved,     // ڱĿ¼֮ƶ/ old_nameΪԭ
+    deleted,   // ɾƳĿ¼ nameΪձʾӶ
+    overflow   // ں¼ Ҫɨ
+  };
+
+  type type_;
+  int watch_;            // add_watchص
+  std::string path_;     // ӵ·
+  std::string name_;     // Ŀ¼еļ
+  std::string old_name_;
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_FILE_EVENT_HPP
@@ -0,0 +1,108 @@
+#ifndef BOOST_ASIO_DETAIL_FILE_IO_POOL_HPP
+#define BOOST_ASIO_DETAIL_FILE_IO_POOL_HPP
+
+#include "event.hpp"
+#include "execution_context.hpp"
+#include "file_op.hpp"
+#include "mutex.hpp"
+#include "op_queue.hpp"
+#include "scheduler.hpp"
+#include "service_registry_helpers.hpp"
+#include "thread_group.hpp"
+
+namespace boost::asio::detail {
+// ļI/O̳߳ io_uringʱʹ
+// ߳ޣ贴ɺѲͶݻio_contextscheduler
+class file_io_pool : public execution_context_service_base<file_io_pool>
+{
+ public:
+  enum
+  {
+    default_max_threads = 4
+  };
+
+  explicit file_io_pool(execution_context& ctx, std::size_t max_threads = default_max_threads)
+      : execution_context_service_base<file_io_pool>(ctx),
+        scheduler_(use_service<scheduler>(ctx)),
+        max_threads_(max_threads ? max_threads : 1),
+        num_threads_(0),
+        idle_threads_(0),
+        shutdown_(false)
+  {}
+
+  ~file_io_pool() { shutdown(); }
+
+  // ֹͣ߳ δִеĲֱӶ
+  void shutdown()
+  {
+    mutex::scoped_lock lock(mutex_);
+    shutdown_ = true;
+    event_.signal_all(lock);
+    lock.unlock();
+    threads_.join();
+
+    lock.lock();
+    op_queue<operation> ops;
+    while (file_op* op = queue_.front()) {
+      queue_.pop();
+      ops.push(op);
+    }
+    lock.unlock();
+    scheduler_.abandon_operations(ops);
+  }
+
+  void submit(file_op* op)
+  {
+    scheduler_.work_started();
+    mutex::scoped_lock lock(mutex_);
+    if (shutdown_) {
+      lock.unlock();
+      op->ec_ = error_code::operation_aborted;
+      scheduler_.post_deferred_completion(op);
+      return;
+    }
+    queue_.push(op);
+    if (idle_threads_ == 0 && num_threads_ < max_threads_) {
+      ++num_threads_;
+      threads_.create_thread([this]() { this->run(); });
+    }
+    event_.unlock_and_signal_one(lock);
+  }
+
+  std::size_t max_threads() const { return max_threads_; }
+
+ private:
+  void run()
+  {
+    mutex::scoped_lock lock(mutex_);
+    for (;;) {
+      while (queue_.empty() && !shutdown_) {
+        event_.clear(lock);
+        ++idle_threads_;
+        event_.wait(lock);
+        --idle_threads_;
+      }
+      if (shutdown_) {
+        return;
+      }
+      file_op* op = queue_.front();
+      queue_.pop();
+      lock.unlock();
+      op->perform_blocking();
+      scheduler_.post_deferred_completion(op);
+      lock.lock();
+    }
+  }
+
+  scheduler& scheduler_;
+  const std::size_t max_threads_;
+  mutex mutex_;
+  event event_;
+  op_queue<file_op> queue_;
+  std::size_t num_threads_;
+  std::size_t idle_threads_;
+  bool shutdown_;
+  thread_group threads_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_FILE_IO_POOL_HPP
@@ -0,0 +1,104 @@
+#ifndef BOOST_ASIO_DETAIL_FILE_OP_HPP
+#define BOOST_ASIO_DETAIL_FILE_OP_HPP
+
+#include <errno.h>
+#include <unistd.h>
+#include <cstdint>
+#include <functional>
+#include "error_code.hpp"
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "scheduler_operation.hpp"
+
+namespace boost::asio::detail {
+// ͨļд io_uringִ̳߳
+class file_op : public scheduler_operation
+{
+ public:
+  static const std::uint64_t current_position = ~std::uint64_t(0);  // ʹļǰλ
+
+  std::error_code ec_;
+  std::size_t bytes_transferred_;
+  int descriptor_;
+  std::uint64_t offset_;
+  void* data_;
+  std::size_t size_;
+  bool is_write_;
+
+  // ִ̳߳
+  void perform_blocking()
+  {
+    for (;;) {
+      ssize_t n;
+      if (offset_ == current_position) {
+        n = is_write_ ? ::write(descriptor_, data_, size_) : ::read(descriptor_, data_, size_);
+      } else {
+        n = is_write_ ? ::pwrite(descriptor_, data_, size_, static_cast<off_t>(offset_))
+                      : ::pread(descriptor_, data_, size_, static_cast<off_t>(offset_));
+      }
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      set_result(n < 0 ? -errno : static_cast<int>(n));
+      return;
+    }
+  }
+
+  // resultΪʱ-errno io_uringcqe->resһ
+  void set_result(int result)
+  {
+    if (result < 0) {
+      ec_ = std::error_code(-result, std::generic_category());
+      bytes_transferred_ = 0;
+    } else {
+      ec_ = (result == 0 && !is_write_ && size_ != 0) ? make_error_code(error_code::eof) : std::error_code();
+      bytes_transferred_ = result;
+    }
+  }
+
+ protected:
+  file_op(int descriptor, std::uint64_t offset, void* data, std::size_t size, bool is_write, func_type complete_func)
+      : scheduler_operation(complete_func),
+        bytes_transferred_(0),
+        descriptor_(descriptor),
+        offset_(offset),
+        data_(data),
+        size_(size),
+        is_write_(is_write)
+  {}
+};
+
+template <typename Handler>
+class file_handler_op : public file_op
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(file_handler_op);
+
+  file_handler_op(int descriptor, std::uint64_t offset, void* data, std::size_t size, bool is_write, Handler& handler)
+      : file_op(descriptor, offset, data, size, is_write, &file_handler_op::do_complete), handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    file_handler_op* o(static_cast<file_handler_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_FILE_OP_HPP
@@ -0,0 +1,237 @@
+#ifndef BOOST_ASIO_DETAIL_FILE_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_FILE_SERVICE_HPP
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <string>
+#include "buffer.hpp"
+#include "config.hpp"
+#include "descriptor_ops.hpp"
+#include "file_io_pool.hpp"
+#include "file_op.hpp"
+#include "io_context.hpp"
+#include "io_uring_service.hpp"
+#include "service_registry_helpers.hpp"
+
+namespace boost::asio::detail {
+// ͨļ epoll˵ͨļǾԶдreactor
+// Ƚio_uringں˲ֻ֧ʱ̳߳
+class file_service : public service_base<file_service>
+{
+ public:
+  using native_handle_type = int;
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    int descriptor_;
+  };
+
+  file_service(io_context& ioc)
+      : service_base<file_service>(ioc),
+        scheduler_(use_service<io_context_impl>(ioc)),
+#if defined(BOOST_ASIO_HAS_IO_URING)
+        uring_(use_service<io_uring_service>(ioc)),
+#endif  // defined(BOOST_ASIO_HAS_IO_URING)
+        pool_(use_service<file_io_pool>(ioc))
+  {}
+
+  void shutdown() {}
+
+  void construct(impl_type& impl) { impl.descriptor_ = -1; }
+
+  void move_construct(impl_type& impl, impl_type& other_impl)
+  {
+    impl.descriptor_ = other_impl.descriptor_;
+    other_impl.descriptor_ = -1;
+  }
+
+  void move_assign(impl_type& impl, file_service&, impl_type& other_impl)
+  {
+    destroy(impl);
+    move_construct(impl, other_impl);
+  }
+
+  void destroy(impl_type& impl)
+  {
+    std::error_code ignored;
+    close(impl, ignored);
+  }
+
+  void open(impl_type& impl, const char* path, int flags, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    int fd = ::open(path, flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      ec = descriptor_ops::last_error();
+      return;
+    }
+    impl.descriptor_ = fd;
+    ec = std::error_code();
+  }
+
+  void assign(impl_type& impl, const native_handle_type& descriptor, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    impl.descriptor_ = descriptor;
+    ec = std::error_code();
+  }
+
+  bool is_open(const impl_type& impl) const { return impl.descriptor_ != -1; }
+
+  native_handle_type native_handle(const impl_type& impl) const { return impl.descriptor_; }
+
+  // ύĶдȡ رǰӦȴ
+  void close(impl_type& impl, std::error_code& ec)
+  {
+    descriptor_ops::close(impl.descriptor_, ec);
+    impl.descriptor_ = -1;
+  }
+
+  native_handle_type release(impl_type& impl)
+  {
+    native_handle_type descriptor = impl.descriptor_;
+    impl.descriptor_ = -1;
+    return descriptor;
+  }
+
+  std::uint64_t size(const impl_type& impl, std::error_code& ec) const
+  {
+    struct stat s;
+    if (::fstat(impl.descriptor_, &s) != 0) {
+      ec = descriptor_ops::last_error();
+      return 0;
+    }
+    ec = std::error_code();
+    return static_cast<std::uint64_t>(s.st_size);
+  }
+
+  void resize(impl_type& impl, std::uint64_t n, std::error_code& ec)
+  {
+    ec = ::ftruncate(impl.descriptor_, static_cast<off_t>(n)) == 0 ? std::error_code() : descriptor_ops::last_error();
+  }
+
+  void sync_all(impl_type& impl, std::error_code& ec)
+  {
+    ec = ::fsync(impl.descriptor_) == 0 ? std::error_code() : descriptor_ops::last_error();
+  }
+
+  void sync_data(impl_type& impl, std::error_code& ec)
+  {
+    ec = ::fdatasync(impl.descriptor_) == 0 ? std::error_code() : descriptor_ops::last_error();
+  }
+
+  std::uint64_t seek(impl_type& impl, std::int64_t offset, int whence, std::error_code& ec)
+  {
+    off_t result = ::lseek(impl.descriptor_, static_cast<off_t>(offset), whence);
+    if (result < 0) {
+      ec = descriptor_ops::last_error();
+      return 0;
+    }
+    ec = std::error_code();
+    return static_cast<std::uint64_t>(result);
+  }
+
+  // ģʽʾ lengthΪ0ʾļĩβ
+  void advise(impl_type& impl, int advice, std::uint64_t offset, std::uint64_t length, std::error_code& ec)
+  {
+    int result = ::posix_fadvise(impl.descriptor_, static_cast<off_t>(offset), static_cast<off_t>(length), advice);
+    ec = result == 0 ? std::error_code() : std::error_code(result, std::generic_category());
+  }
+
+  // ǰļݶҳ
+  void readahead(impl_type& impl, std::uint64_t offset, std::size_t length, std::error_code& ec)
+  {
+    ec = ::readahead(impl.descriptor_, static_cast<off64_t>(offset), length) == 0 ? std::error_code()
+                                                                                   : descriptor_ops::last_error();
+  }
+
+  std::size_t read_some_at(impl_type& impl, std::uint64_t offset, const mutable_buffer& buffer, std::error_code& ec)
+  {
+    sync_op op(impl.descriptor_, offset, buffer.data(), buffer.size(), false);
+    return op.run(ec);
+  }
+
+  std::size_t write_some_at(impl_type& impl, std::uint64_t offset, const const_buffer& buffer, std::error_code& ec)
+  {
+    sync_op op(impl.descriptor_, offset, const_cast<void*>(buffer.data()), buffer.size(), true);
+    return op.run(ec);
+  }
+
+  // offsetΪfile_op::current_positionʱļǰλöдƶλ
+  template <typename Handler>
+  void async_read_some_at(impl_type& impl, std::uint64_t offset, const mutable_buffer& buffer, Handler& handler)
+  {
+    using op = file_handler_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.descriptor_, offset, buffer.data(), buffer.size(), false, handler);
+    start_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+  template <typename Handler>
+  void async_write_some_at(impl_type& impl, std::uint64_t offset, const const_buffer& buffer, Handler& handler)
+  {
+    using op = file_handler_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.descriptor_, offset, const_cast<void*>(buffer.data()), buffer.size(), true, handler);
+    start_op(impl, p.p);
+    p.v = p.p = 0;
+  }
+
+ private:
+  class sync_op : public file_op
+  {
+   public:
+    sync_op(int descriptor, std::uint64_t offset, void* data, std::size_t size, bool is_write)
+        : file_op(descriptor, offset, data, size, is_write, 0)
+    {}
+
+    std::size_t run(std::error_code& ec)
+    {
+      if (descriptor_ == -1) {
+        ec = std::error_code(EBADF, std::generic_category());
+        return 0;
+      }
+      if (size_ == 0) {
+        ec = std::error_code();
+        return 0;
+      }
+      perform_blocking();
+      ec = ec_;
+      return bytes_transferred_;
+    }
+  };
+
+  void start_op(impl_type& impl, file_op* op)
+  {
+    if (impl.descriptor_ == -1 || op->size_ == 0) {
+      if (impl.descriptor_ == -1) {
+        op->ec_ = std::error_code(EBADF, std::generic_category());
+      }
+      scheduler_.post_immediate_completion(op, false);
+      return;
+    }
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    if (uring_.enabled() && uring_.submit(op)) {
+      return;
+    }
+#endif  // defined(BOOST_ASIO_HAS_IO_URING)
+    pool_.submit(op);
+  }
+
+  io_context_impl& scheduler_;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  io_uring_service& uring_;
+#endif  // defined(BOOST_ASIO_HAS_IO_URING)
+  file_io_pool& pool_;  // ߳ڵһʹʱŴ
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_FILE_SERVICE_HPP
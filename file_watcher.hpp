@@ -0,0 +1,141 @@
+#ifndef BOOST_ASIO_FILE_WATCHER_HPP
+#define BOOST_ASIO_FILE_WATCHER_HPP
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+#include "async_result.hpp"
+#include "basic_io_object.hpp"
+#include "file_event.hpp"
+#include "inotify_service.hpp"
+#include "steady_timer.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+namespace detail {
+
+// file_watcher::async_waitϲ
+// ȴһ¼ ϲڷ0ʱٵһڣѴڵ¼ϲһ𽻸handler
+template <typename Watcher, typename Handler>
+class file_watcher_op
+{
+ public:
+  file_watcher_op(Watcher& watcher, Handler& handler) : watcher_(watcher), waited_(false), handler_(std::move(handler))
+  {}
+
+  file_watcher_op(const file_watcher_op& other) = default;
+  file_watcher_op(file_watcher_op&& other) = default;
+
+  void operator()(const std::error_code& ec, int start = 0)
+  {
+    switch (start) {
+      case 1:
+        watcher_.get_service().async_read_events(watcher_.get_impl(), *this);
+        return;
+      default:
+        if (!ec && !waited_ && watcher_.window_.count() > 0) {
+          waited_ = true;
+          watcher_.timer_.expires_after(watcher_.window_);
+          watcher_.timer_.async_wait(std::move(*this));
+          return;
+        }
+
+        std::error_code result_ec(ec);
+        std::vector<file_event> events;
+        if (!result_ec) {
+          watcher_.get_service().read_events(watcher_.get_impl(), result_ec);
+          events = watcher_.get_service().take_events(watcher_.get_impl());
+        }
+        handler_(result_ec, std::move(events));
+    }
+  }
+
+ private:
+  Watcher& watcher_;
+  bool waited_;
+  Handler handler_;
+};
+}  // namespace detail
+
+// inotifyļϵͳ
+// ں¼Ϊcreated/modified/moved/deletedϲͬļظ¼
+class file_watcher : public basic_io_object<detail::inotify_service>
+{
+ public:
+  using duration = std::chrono::steady_clock::duration;
+
+  enum
+  {
+    default_mask = detail::inotify_service::default_mask
+  };
+
+  explicit file_watcher(io_context& ioc) : basic_io_object<detail::inotify_service>(ioc), timer_(ioc), window_(0) {}
+
+  ~file_watcher() {}
+
+  // ʼļĿ¼ ؼ
+  int add_watch(const std::string& path, std::uint32_t mask = default_mask)
+  {
+    std::error_code ec;
+    int wd = this->get_service().add_watch(this->get_impl(), path, mask, ec);
+    if (ec) detail::throw_exception(ec);
+    return wd;
+  }
+
+  int add_watch(const std::string& path, std::uint32_t mask, std::error_code& ec)
+  {
+    return this->get_service().add_watch(this->get_impl(), path, mask, ec);
+  }
+
+  void remove_watch(int wd)
+  {
+    std::error_code ec;
+    this->get_service().remove_watch(this->get_impl(), wd, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void remove_watch(int wd, std::error_code& ec) { this->get_service().remove_watch(this->get_impl(), wd, ec); }
+
+  // һ¼ռwindowʱٻص 0ʾص
+  void set_coalesce_window(const duration& window) { window_ = window; }
+  duration coalesce_window() const { return window_; }
+
+  void cancel()
+  {
+    std::error_code ec;
+    this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    timer_.cancel();
+  }
+
+  void close()
+  {
+    std::error_code ec;
+    timer_.cancel();
+    this->get_service().close(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  // ȴһļ¼ handler: void(std::error_code, std::vector<file_event>)
+  template <typename WaitHandler>
+  typename detail::async_result_helper<WaitHandler, void(std::error_code, std::vector<file_event>)>::result_type
+  async_wait(WaitHandler&& handler)
+  {
+    using handler_type =
+        typename detail::async_result_helper<WaitHandler, void(std::error_code, std::vector<file_event>)>::handler_type;
+    async_completion<WaitHandler, void(std::error_code, std::vector<file_event>)> init(handler);
+
+    detail::file_watcher_op<file_watcher, std::decay_t<handler_type>>(*this, init.handler_)(std::error_code(), 1);
+    return init.result_.get();
+  }
+
+ private:
+  template <typename, typename>
+  friend class detail::file_watcher_op;
+
+  steady_timer timer_;
+  duration window_;
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_FILE_WATCHER_HPP
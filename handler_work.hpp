@@ -1,4 +1,4 @@
-#ifndef BOOST_ASIO_DETAIL_HANDLER_WORK_HP
+#ifndef BOOST_ASIO_DETAIL_HANDLER_WORK_HPP
 #define BOOST_ASIO_DETAIL_HANDLER_WORK_HPP
 
 #include "associated_executor.hpp"
@@ -0,0 +1,300 @@
+#ifndef BOOST_ASIO_DETAIL_INOTIFY_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_INOTIFY_SERVICE_HPP
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "descriptor_ops.hpp"
+#include "epoll_reactor.hpp"
+#include "fenced_block.hpp"
+#include "file_event.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "io_context.hpp"
+#include "reactor_op.hpp"
+#include "service_registry_helpers.hpp"
+
+namespace boost::asio::detail {
+// inotify ÿfile_watcherһinotifyעᵽepoll_reactor
+// ɶʱں¼file_eventϲظ¼
+class inotify_service : public service_base<inotify_service>
+{
+ public:
+  enum
+  {
+    default_mask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+                   IN_DELETE_SELF | IN_MOVE_SELF
+  };
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    int descriptor_;
+    epoll_reactor::ptr_descriptor_data reactor_data_;
+    std::map<int, std::string> watches_;  //  -> ·
+    std::vector<file_event> events_;      // ѽδhandler¼
+    std::map<std::uint32_t, std::size_t> moves_;  // IN_MOVED_FROMcookie -> events_±
+  };
+
+  inotify_service(io_context& ioc) : service_base<inotify_service>(ioc), reactor_(use_service<epoll_reactor>(ioc))
+  {
+    reactor_.init_task();
+  }
+
+  void shutdown() {}
+
+  void construct(impl_type& impl)
+  {
+    impl.descriptor_ = -1;
+    impl.reactor_data_ = 0;
+  }
+
+  void destroy(impl_type& impl)
+  {
+    std::error_code ignored;
+    close(impl, ignored);
+  }
+
+  void open(impl_type& impl, std::error_code& ec)
+  {
+    if (impl.descriptor_ != -1) {
+      ec = std::error_code();
+      return;
+    }
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+      ec = descriptor_ops::last_error();
+      return;
+    }
+    if (int err = reactor_.register_descriptor(fd, impl.reactor_data_)) {
+      ec = std::error_code(err, std::generic_category());
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      ::close(fd);
+      return;
+    }
+    impl.descriptor_ = fd;
+    ec = std::error_code();
+  }
+
+  void close(impl_type& impl, std::error_code& ec)
+  {
+    if (impl.descriptor_ != -1) {
+      reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_, true);
+      descriptor_ops::close(impl.descriptor_, ec);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.descriptor_ = -1;
+    } else {
+      ec = std::error_code();
+    }
+    impl.watches_.clear();
+    impl.events_.clear();
+    impl.moves_.clear();
+  }
+
+  int add_watch(impl_type& impl, const std::string& path, std::uint32_t mask, std::error_code& ec)
+  {
+    open(impl, ec);
+    if (ec) {
+      return -1;
+    }
+    int wd = ::inotify_add_watch(impl.descriptor_, path.c_str(), mask);
+    if (wd < 0) {
+      ec = descriptor_ops::last_error();
+      return -1;
+    }
+    impl.watches_[wd] = path;
+    ec = std::error_code();
+    return wd;
+  }
+
+  void remove_watch(impl_type& impl, int wd, std::error_code& ec)
+  {
+    if (impl.watches_.erase(wd) == 0) {
+      ec = std::error_code(EINVAL, std::generic_category());
+      return;
+    }
+    ec = ::inotify_rm_watch(impl.descriptor_, wd) == 0 ? std::error_code() : descriptor_ops::last_error();
+  }
+
+  void cancel(impl_type& impl, std::error_code& ec)
+  {
+    reactor_.cancel_ops(impl.descriptor_, impl.reactor_data_);
+    ec = std::error_code();
+  }
+
+  // ضǰ¼ falseʾû
+  bool read_events(impl_type& impl, std::error_code& ec)
+  {
+    alignas(inotify_event) char buffer[16 * 1024];
+    bool any = false;
+    ec = std::error_code();
+    for (;;) {
+      ssize_t n = ::read(impl.descriptor_, buffer, sizeof(buffer));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        if (!descriptor_ops::would_block(errno)) {
+          ec = descriptor_ops::last_error();
+          return true;
+        }
+        return any;
+      }
+      parse(impl, buffer, static_cast<std::size_t>(n));
+      any = true;
+    }
+  }
+
+  std::vector<file_event> take_events(impl_type& impl)
+  {
+    std::vector<file_event> events;
+    events.swap(impl.events_);
+    impl.moves_.clear();
+    return events;
+  }
+
+  // ȴһ¼ handler: void(std::error_code)¼impl
+  template <typename Handler>
+  void async_read_events(impl_type& impl, Handler& handler)
+  {
+    using op = read_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(this, impl, handler);
+    if (impl.descriptor_ == -1) {
+      p.p->ec_ = std::error_code(EBADF, std::generic_category());
+      reactor_.post_immediate_completion(p.p, false);
+    } else if (!impl.events_.empty()) {
+      reactor_.post_immediate_completion(p.p, false);
+    } else {
+      reactor_.start_op(epoll_reactor::read_op, impl.descriptor_, impl.reactor_data_, p.p, false, true);
+    }
+    p.v = p.p = 0;
+  }
+
+ private:
+  class read_op_base : public reactor_op
+  {
+   public:
+    read_op_base(inotify_service* service, impl_type& impl, func_type complete_func)
+        : reactor_op(&read_op_base::do_perform, complete_func), service_(service), impl_(impl)
+    {}
+
+    static status do_perform(reactor_op* base)
+    {
+      read_op_base* o(static_cast<read_op_base*>(base));
+      if (!o->service_->read_events(o->impl_, o->ec_)) {
+        return not_done;
+      }
+      return (o->ec_ || !o->impl_.events_.empty()) ? done : not_done;
+    }
+
+   private:
+    inotify_service* service_;
+    impl_type& impl_;
+  };
+
+  template <typename Handler>
+  class read_op : public read_op_base
+  {
+   public:
+    BOOST_ASIO_DEFINE_HANDLER_PTR(read_op);
+
+    read_op(inotify_service* service, impl_type& impl, Handler& handler)
+        : read_op_base(service, impl, &read_op::do_complete), handler_(std::move(handler))
+    {
+      handler_work<Handler>::start(handler_);
+    }
+
+    static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+    {
+      read_op* o(static_cast<read_op*>(base));
+      ptr p = {std::addressof(o->handler_), o, o};
+      handler_work<Handler> w(o->handler_);
+
+      Handler handler(std::move(o->handler_));
+      std::error_code ec(o->ec_);
+      p.reset();
+      if (owner) {
+        fenced_block b(fenced_block::half);
+        w.complate(std::bind(handler, ec), handler);
+      }
+    }
+
+   private:
+    Handler handler_;
+  };
+
+  // һinotify_event ɶԵIN_MOVED_FROM/IN_MOVED_TOcookieϲmoved
+  static void parse(impl_type& impl, const char* buffer, std::size_t size)
+  {
+    for (std::size_t pos = 0; pos + sizeof(inotify_event) <= size;) {
+      const inotify_event* e = reinterpret_cast<const inotify_event*>(buffer + pos);
+      pos += sizeof(inotify_event) + e->len;
+
+      std::string name = e->len ? std::string(e->name) : std::string();
+      if (e->mask & IN_Q_OVERFLOW) {
+        add_event(impl, file_event::overflow, -1, std::string(), std::string());
+      } else if (e->mask & IN_IGNORED) {
+        impl.watches_.erase(e->wd);
+      } else if (e->mask & IN_MOVED_FROM) {
+        impl.moves_[e->cookie] = add_event(impl, file_event::deleted, e->wd, name, std::string());
+      } else if (e->mask & IN_MOVED_TO) {
+        std::map<std::uint32_t, std::size_t>::iterator it = impl.moves_.find(e->cookie);
+        if (it != impl.moves_.end()) {
+          file_event& moved = impl.events_[it->second];
+          moved.type_ = file_event::moved;
+          moved.old_name_ = moved.name_;
+          moved.name_ = name;
+          moved.watch_ = e->wd;
+          moved.path_ = watch_path(impl, e->wd);
+          impl.moves_.erase(it);
+        } else {
+          add_event(impl, file_event::created, e->wd, name, std::string());
+        }
+      } else if (e->mask & IN_CREATE) {
+        add_event(impl, file_event::created, e->wd, name, std::string());
+      } else if (e->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+        add_event(impl, file_event::modified, e->wd, name, std::string());
+      } else if (e->mask & (IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF)) {
+        add_event(impl, file_event::deleted, e->wd, name, std::string());
+      }
+    }
+  }
+
+  static std::string watch_path(const impl_type& impl, int wd)
+  {
+    std::map<int, std::string>::const_iterator it = impl.watches_.find(wd);
+    return it != impl.watches_.end() ? it->second : std::string();
+  }
+
+  // ֻͬһļһ¼ϲ: ½޸֮޸Ĳٵ
+  // ˳(½ɾ½)֤һ¼ļ״̬
+  // ¼events_е±
+  static std::size_t add_event(impl_type& impl, file_event::type type, int wd, const std::string& name,
+                               const std::string& old_name)
+  {
+    for (std::size_t i = impl.events_.size(); i-- > 0;) {
+      const file_event& e = impl.events_[i];
+      if (e.watch_ == wd && e.name_ == name) {
+        if (type == file_event::modified && (e.type_ == file_event::created || e.type_ == file_event::modified)) {
+          return i;
+        }
+        break;
+      }
+    }
+    file_event e;
+    e.type_ = type;
+    e.watch_ = wd;
+    e.path_ = watch_path(impl, wd);
+    e.name_ = name;
+    e.old_name_ = old_name;
+    impl.events_.push_back(e);
+    return impl.events_.size() - 1;
+  }
+
+  epoll_reactor& reactor_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_INOTIFY_SERVICE_HPP
@@ -1,7 +1,9 @@
 #include "io_context.hpp"
 #include <iostream>
+#include "epoll_reactor.hpp"
 #include "error_code.hpp"
 #include "service_registry_helpers.hpp"
+#include "strand_executor_service.hpp"
 #include "throw_exception.hpp"
 
 namespace boost::asio {
@@ -22,7 +24,7 @@ io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
   return *unique_impl.release();
 }
 
-io_context::~io_context() {}
+io_context::~io_context() { shutdown(); }
 
 io_context::executor_type io_context::get_executor() { return executor_type(*this); }
 
@@ -74,6 +76,30 @@ void io_context::restart() { impl_.restart(); }
 
 void io_context::reset() { restart(); }
 
+void io_context::enable_timer_statistics() { use_service<detail::epoll_reactor>(*this).enable_timer_statistics(); }
+
+io_context_statistics io_context::statistics()
+{
+  io_context_statistics statistics;
+  if (has_service<detail::epoll_reactor>(*this)) {
+    use_service<detail::epoll_reactor>(*this).timer_statistics(statistics.timers);
+  }
+  if (has_service<detail::strand_executor_service>(*this)) {
+    use_service<detail::strand_executor_service>(*this).statistics(statistics.strands);
+  }
+  return statistics;
+}
+
+void io_context::reset_statistics()
+{
+  if (has_service<detail::epoll_reactor>(*this)) {
+    use_service<detail::epoll_reactor>(*this).reset_timer_statistics();
+  }
+  if (has_service<detail::strand_executor_service>(*this)) {
+    use_service<detail::strand_executor_service>(*this).reset_statistics();
+  }
+}
+
 void io_context::executor_type::on_work_started() const { io_context_.impl_.work_started(); }
 
 void io_context::executor_type::on_work_finished() const { io_context_.impl_.work_finished(); }
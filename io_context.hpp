@@ -12,7 +12,9 @@
 #include "executor_op.hpp"
 #include "fenced_block.hpp"
 #include "noncopyable.hpp"
+#include "strand_statistics.hpp"
 #include "throw_exception.hpp"
+#include "timer_statistics.hpp"
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 #include "win_iocp_io_context.hpp"
@@ -31,6 +33,13 @@ using io_context_impl = scheduler;
 #endif
 }  // namespace detail
 
+// io_contextͳ
+struct io_context_statistics
+{
+  timer_statistics timers;    // жʱкϲ
+  strand_statistics strands;  // strandĵȼ
+};
+
 class io_context : public execution_context
 {
  public:
@@ -105,6 +114,13 @@ class io_context : public execution_context
   void restart();
   void reset();
 
+  // ʱͳ Ĭϲ¼strandǼ¼
+  void enable_timer_statistics();
+
+  // ͳƿ ̵߳ ᴴûʹõķ
+  io_context_statistics statistics();
+  void reset_statistics();
+
  private:
   template <typename Service>
   friend Service& use_service(io_context& ioc);
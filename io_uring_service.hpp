@@ -0,0 +1,310 @@
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+
+#include "config.hpp"
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include "epoll_reactor.hpp"
+#include "execution_context.hpp"
+#include "file_op.hpp"
+#include "mutex.hpp"
+#include "op_queue.hpp"
+#include "reactor_op.hpp"
+#include "scheduler.hpp"
+#include "service_registry_helpers.hpp"
+
+namespace boost::asio::detail {
+// io_uringִͨļд liburingֱʹϵͳúmmapĻζ
+// ¼ͨעeventfd֪ͨeventfdΪڲעᵽepoll_reactor
+// ں˲֧ʱenabled()Ϊfalseɵ˻̳߳
+class io_uring_service : public execution_context_service_base<io_uring_service>
+{
+ public:
+  enum
+  {
+    default_ring_size = 256,
+    max_transfer = 0x7ffff000  // ں˶read/writeγȵһ Զ̶д
+  };
+
+  explicit io_uring_service(execution_context& ctx, unsigned ring_size = default_ring_size)
+      : execution_context_service_base<io_uring_service>(ctx),
+        scheduler_(use_service<scheduler>(ctx)),
+        reactor_(use_service<epoll_reactor>(ctx)),
+        ring_fd_(-1),
+        event_fd_(-1),
+        sq_ring_(0),
+        cq_ring_(0),
+        sqes_(0),
+        sq_ring_size_(0),
+        cq_ring_size_(0),
+        sq_entries_(0),
+        cq_entries_(0),
+        outstanding_(0),
+        reactor_data_(0),
+        drain_op_(this)
+  {
+    if (!init(ring_size)) {
+      cleanup();
+      return;
+    }
+    reactor_.init_task();
+    reactor_.register_internal_descriptor(epoll_reactor::read_op, event_fd_, reactor_data_, &drain_op_);
+  }
+
+  ~io_uring_service() { cleanup(); }
+
+  // ȴύĲ ڴ֮ǰͷ
+  void shutdown()
+  {
+    if (ring_fd_ == -1) {
+      return;
+    }
+    reactor_.deregister_internal_descriptor(event_fd_, reactor_data_);
+    reactor_.cleanup_descriptor_data(reactor_data_);
+
+    op_queue<operation> ops;
+    mutex::scoped_lock lock(mutex_);
+    while (outstanding_ > 0) {
+      if (enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+        break;
+      }
+      reap(ops);
+    }
+    lock.unlock();
+    scheduler_.abandon_operations(ops);
+  }
+
+  bool enabled() const { return ring_fd_ != -1; }
+
+  // ύһд ύʧʱfalse
+  bool submit(file_op* op)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (outstanding_ >= cq_entries_) {  // ֤ɶв
+      return false;
+    }
+
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op->is_write_ ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = op->descriptor_;
+    sqe->off = op->offset_;
+    sqe->addr = reinterpret_cast<std::uint64_t>(op->data_);
+    sqe->len = static_cast<std::uint32_t>(std::min<std::size_t>(op->size_, max_transfer));
+    sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    int result;
+    do {
+      result = enter(1, 0, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result != 1) {
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);  // ںûȡ 
+      return false;
+    }
+    ++outstanding_;
+    scheduler_.work_started();
+    return true;
+  }
+
+ private:
+  // eventfdɶʱոɶ һֱreactorĶ
+  class drain_op : public reactor_op
+  {
+   public:
+    drain_op(io_uring_service* service)
+        : reactor_op(&drain_op::do_perform, &drain_op::do_complete), service_(service)
+    {}
+
+    static status do_perform(reactor_op* base)
+    {
+      io_uring_service* service = static_cast<drain_op*>(base)->service_;
+      std::uint64_t counter;
+      while (::read(service->event_fd_, &counter, sizeof(counter)) < 0 && errno == EINTR) {
+      }
+
+      op_queue<operation> ops;
+      mutex::scoped_lock lock(service->mutex_);
+      service->reap(ops);
+      lock.unlock();
+      service->scheduler_.post_deferred_completions(ops);
+      return not_done;
+    }
+
+    static void do_complete(void*, operation*, const std::error_code&, std::size_t) {}
+
+   private:
+    io_uring_service* service_;
+  };
+
+  int enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+  {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, 0, 0));
+  }
+
+  void reap(op_queue<operation>& ops)
+  {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+      file_op* op = reinterpret_cast<file_op*>(cqe->user_data);
+      op->set_result(cqe->res);
+      ops.push(op);
+      --outstanding_;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+  bool init(unsigned ring_size)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CLAMP;
+    ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, ring_size, &params));
+    if (ring_fd_ < 0) {
+      ring_fd_ = -1;
+      return false;
+    }
+    if (!probe_read_write()) {
+      return false;
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = (sq_ring_size_ > cq_ring_size_ ? sq_ring_size_ : cq_ring_size_);
+    }
+
+    void* sq = ::mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+      return false;
+    }
+    sq_ring_ = static_cast<char*>(sq);
+
+    if (single_mmap) {
+      cq_ring_ = sq_ring_;
+    } else {
+      void* cq = ::mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_CQ_RING);
+      if (cq == MAP_FAILED) {
+        return false;
+      }
+      cq_ring_ = static_cast<char*>(cq);
+    }
+
+    void* sqes = ::mmap(0, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+    sq_entries_ = params.sq_entries;
+
+    sq_tail_ = reinterpret_cast<unsigned*>(sq_ring_ + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq_ring_ + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq_ring_ + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned*>(cq_ring_ + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq_ring_ + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq_ring_ + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq_ring_ + params.cq_off.cqes);
+    cq_entries_ = params.cq_entries;
+
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+      event_fd_ = -1;
+      return false;
+    }
+    if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0) {
+      return false;
+    }
+    return true;
+  }
+
+  // 5.1~5.5ں˿ԴIORING_OP_READ/WRITE-EINVAL
+  // ЩںҲ֧IORING_REGISTER_PROBE̽ʧͬΪ
+  bool probe_read_write()
+  {
+    enum
+    {
+      probe_ops = IORING_OP_WRITE + 1
+    };
+    alignas(io_uring_probe) char storage[sizeof(io_uring_probe) + probe_ops * sizeof(io_uring_probe_op)];
+    std::memset(storage, 0, sizeof(storage));
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage);
+    if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe, probe_ops) != 0) {
+      return false;
+    }
+    const int opcodes[] = {IORING_OP_READ, IORING_OP_WRITE};
+    for (int opcode : opcodes) {
+      if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void cleanup()
+  {
+    if (sqes_) {
+      ::munmap(sqes_, sq_entries_ * sizeof(io_uring_sqe));
+      sqes_ = 0;
+    }
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+    cq_ring_ = 0;
+    if (sq_ring_) {
+      ::munmap(sq_ring_, sq_ring_size_);
+      sq_ring_ = 0;
+    }
+    if (event_fd_ != -1) {
+      ::close(event_fd_);
+      event_fd_ = -1;
+    }
+    if (ring_fd_ != -1) {
+      ::close(ring_fd_);
+      ring_fd_ = -1;
+    }
+  }
+
+  scheduler& scheduler_;
+  epoll_reactor& reactor_;
+  mutex mutex_;
+  int ring_fd_;
+  int event_fd_;
+  char* sq_ring_;
+  char* cq_ring_;
+  io_uring_sqe* sqes_;
+  std::size_t sq_ring_size_;
+  std::size_t cq_ring_size_;
+  unsigned sq_entries_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  io_uring_cqe* cqes_;
+  unsigned cq_entries_;
+  unsigned outstanding_;
+  epoll_reactor::ptr_descriptor_data reactor_data_;
+  drain_op drain_op_;
+};
+}  // namespace boost::asio::detail
+
+#endif  // defined(BOOST_ASIO_HAS_IO_URING)
+#endif  // !BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
@@ -0,0 +1,143 @@
+#ifndef BOOST_ASIO_LOCAL_ANCILLARY_HPP
+#define BOOST_ASIO_LOCAL_ANCILLARY_HPP
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include "socket_ops.hpp"
+
+namespace boost::asio::local {
+
+// AF_UNIX SCM_RIGHTSSCM_CREDENTIALSpid/uid/gid
+// ӵ: ͷͺйرգշرյ
+// ʽsocketĸݸڵһֽϣʱ1ֽ
+class ancillary
+{
+ public:
+  enum
+  {
+    max_fds = 16
+  };
+
+  ancillary() : fd_count_(0), has_credentials_(false), truncated_(false), credentials_() {}
+
+  // һҪ͵ ʱfalse
+  bool add_fd(int fd)
+  {
+    if (fd_count_ == max_fds) {
+      return false;
+    }
+    fds_[fd_count_++] = fd;
+    return true;
+  }
+
+  std::size_t fd_count() const { return fd_count_; }
+  int fd(std::size_t i) const { return fds_[i]; }
+
+  // ̵ƾ֤ ں˻У
+  void set_credentials()
+  {
+    credentials_.pid = ::getpid();
+    credentials_.uid = ::getuid();
+    credentials_.gid = ::getgid();
+    has_credentials_ = true;
+  }
+
+  void set_credentials(const ucred& credentials)
+  {
+    credentials_ = credentials;
+    has_credentials_ = true;
+  }
+
+  // շҪpass_credentialsѡŻյƾ֤
+  bool has_credentials() const { return has_credentials_; }
+  const ucred& credentials() const { return credentials_; }
+
+  //  ѱں˹ر
+  bool truncated() const { return truncated_; }
+
+  void clear()
+  {
+    fd_count_ = 0;
+    has_credentials_ = false;
+    truncated_ = false;
+  }
+
+  // رյ
+  void close_fds()
+  {
+    for (std::size_t i = 0; i < fd_count_; ++i) {
+      ::close(fds_[i]);
+    }
+    fd_count_ = 0;
+  }
+
+  // 뵽ƻ ؿݳ
+  std::size_t encode(void* control) const
+  {
+    std::memset(control, 0, control_size);
+    msghdr msg = msghdr();
+    msg.msg_control = control;
+    msg.msg_controllen = control_size;
+    std::size_t len = 0;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (fd_count_) {
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count_);
+      std::memcpy(CMSG_DATA(cmsg), fds_, sizeof(int) * fd_count_);
+      len += CMSG_SPACE(sizeof(int) * fd_count_);
+      cmsg = reinterpret_cast<cmsghdr*>(static_cast<char*>(control) + len);
+    }
+    if (has_credentials_) {
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_CREDENTIALS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(ucred));
+      std::memcpy(CMSG_DATA(cmsg), &credentials_, sizeof(ucred));
+      len += CMSG_SPACE(sizeof(ucred));
+    }
+    return len;
+  }
+
+  // recvmsgصĿݽ
+  void decode(void* control, std::size_t control_len, int msg_flags)
+  {
+    clear();
+    truncated_ = (msg_flags & MSG_CTRUNC) != 0;
+    msghdr msg = msghdr();
+    msg.msg_control = control;
+    msg.msg_controllen = control_len;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET) {
+        continue;
+      }
+      if (cmsg->cmsg_type == SCM_RIGHTS) {
+        std::size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const unsigned char* data = CMSG_DATA(cmsg);
+        for (std::size_t i = 0; i < n; ++i) {
+          int fd;
+          std::memcpy(&fd, data + i * sizeof(int), sizeof(int));
+          if (!add_fd(fd)) {
+            ::close(fd);
+            truncated_ = true;
+          }
+        }
+      } else if (cmsg->cmsg_type == SCM_CREDENTIALS) {
+        std::memcpy(&credentials_, CMSG_DATA(cmsg), sizeof(ucred));
+        has_credentials_ = true;
+      }
+    }
+  }
+
+  // ƻС 㹻max_fdsһƾ֤
+  static const std::size_t control_size = CMSG_SPACE(sizeof(int) * max_fds) + CMSG_SPACE(sizeof(ucred));
+
+ private:
+  int fds_[max_fds];
+  std::size_t fd_count_;
+  bool has_credentials_;
+  bool truncated_;
+  ucred credentials_;
+};
+}  // namespace boost::asio::local
+#endif  // !BOOST_ASIO_LOCAL_ANCILLARY_HPP
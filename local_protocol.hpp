@@ -0,0 +1,114 @@
+#ifndef BOOST_ASIO_LOCAL_PROTOCOL_HPP
+#define BOOST_ASIO_LOCAL_PROTOCOL_HPP
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "throw_exception.hpp"
+
+namespace boost::asio::local {
+
+template <typename Protocol>
+class basic_local_socket;
+
+template <typename Protocol>
+class basic_local_acceptor;
+
+// AF_UNIXַ ·'\0'ͷʱΪռ
+template <typename Protocol>
+class basic_endpoint
+{
+ public:
+  using protocol_type = Protocol;
+
+  basic_endpoint() : size_(offsetof(sockaddr_un, sun_path)) { init(); }
+
+  basic_endpoint(std::string_view path) : size_(offsetof(sockaddr_un, sun_path))
+  {
+    init();
+    if (path.size() > sizeof(data_.sun_path) - 1) {
+      detail::throw_exception(std::length_error("local endpoint path too long"));
+    }
+    std::memcpy(data_.sun_path, path.data(), path.size());
+    size_ += path.size();
+    if (!path.empty() && path[0] != 0) {
+      size_ += 1;  // ļ·Ͻβ'\0'
+    }
+  }
+
+  protocol_type protocol() const { return protocol_type(); }
+
+  void* data() { return &data_; }
+  const void* data() const { return &data_; }
+  socklen_t size() const { return size_; }
+  socklen_t capacity() const { return sizeof(data_); }
+  void resize(socklen_t new_size) { size_ = new_size > sizeof(data_) ? sizeof(data_) : new_size; }
+
+  std::string path() const
+  {
+    std::size_t len = size_ - offsetof(sockaddr_un, sun_path);
+    if (len > 0 && data_.sun_path[0] != 0 && data_.sun_path[len - 1] == 0) {
+      --len;
+    }
+    return std::string(data_.sun_path, len);
+  }
+
+  friend bool operator==(const basic_endpoint& a, const basic_endpoint& b) { return a.path() == b.path(); }
+  friend bool operator!=(const basic_endpoint& a, const basic_endpoint& b) { return !(a == b); }
+
+ private:
+  void init()
+  {
+    std::memset(&data_, 0, sizeof(data_));
+    data_.sun_family = AF_UNIX;
+  }
+
+  sockaddr_un data_;
+  socklen_t size_;
+};
+
+class stream_protocol
+{
+ public:
+  int type() const { return SOCK_STREAM; }
+  int protocol() const { return 0; }
+  int family() const { return AF_UNIX; }
+
+  using endpoint = basic_endpoint<stream_protocol>;
+  using socket = basic_local_socket<stream_protocol>;
+  using acceptor = basic_local_acceptor<stream_protocol>;
+};
+
+class datagram_protocol
+{
+ public:
+  int type() const { return SOCK_DGRAM; }
+  int protocol() const { return 0; }
+  int family() const { return AF_UNIX; }
+
+  using endpoint = basic_endpoint<datagram_protocol>;
+  using socket = basic_local_socket<datagram_protocol>;
+};
+
+// SO_PASSCRED շ򿪺ÿϢͷƾ֤
+class pass_credentials
+{
+ public:
+  explicit pass_credentials(bool value = true) : value_(value ? 1 : 0) {}
+
+  bool value() const { return value_ != 0; }
+  int level() const { return SOL_SOCKET; }
+  int name() const { return SO_PASSCRED; }
+  const void* data() const { return &value_; }
+  void* data() { return &value_; }
+  socklen_t size() const { return sizeof(value_); }
+
+ private:
+  int value_;
+};
+}  // namespace boost::asio::local
+#endif  // !BOOST_ASIO_LOCAL_PROTOCOL_HPP
@@ -0,0 +1,427 @@
+#ifndef BOOST_ASIO_LOCAL_SOCKET_HPP
+#define BOOST_ASIO_LOCAL_SOCKET_HPP
+
+#include <utility>
+#include "async_result.hpp"
+#include "basic_io_object.hpp"
+#include "local_ancillary.hpp"
+#include "local_protocol.hpp"
+#include "reactive_socket_service.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio::local {
+
+class socket_base
+{
+ public:
+  enum wait_type
+  {
+    wait_read = detail::epoll_reactor::read_op,
+    wait_write = detail::epoll_reactor::write_op,
+    wait_error = detail::epoll_reactor::except_op
+  };
+
+  enum shutdown_type
+  {
+    shutdown_receive = SHUT_RD,
+    shutdown_send = SHUT_WR,
+    shutdown_both = SHUT_RDWR
+  };
+
+  enum
+  {
+    max_listen_connections = SOMAXCONN
+  };
+
+ protected:
+  ~socket_base() {}
+};
+
+// AF_UNIX socket stream_protocol::socketdatagram_protocol::socket
+// ancillaryշڴƾ֤
+template <typename Protocol>
+class basic_local_socket : public basic_io_object<detail::reactive_socket_service<Protocol>>, public socket_base
+{
+  using service_type = detail::reactive_socket_service<Protocol>;
+
+ public:
+  using protocol_type = Protocol;
+  using endpoint_type = typename Protocol::endpoint;
+  using native_handle_type = typename service_type::native_handle_type;
+
+  explicit basic_local_socket(io_context& ioc) : basic_io_object<service_type>(ioc) {}
+
+  basic_local_socket(io_context& ioc, const protocol_type& protocol) : basic_io_object<service_type>(ioc)
+  {
+    open(protocol);
+  }
+
+  // 򿪲󶨵صַ
+  basic_local_socket(io_context& ioc, const endpoint_type& endpoint) : basic_io_object<service_type>(ioc)
+  {
+    open(endpoint.protocol());
+    bind(endpoint);
+  }
+
+  ~basic_local_socket() {}
+
+  void open(const protocol_type& protocol = protocol_type())
+  {
+    std::error_code ec;
+    this->get_service().open(this->get_impl(), protocol, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void assign(const protocol_type& protocol, const native_handle_type& socket)
+  {
+    std::error_code ec;
+    this->get_service().assign(this->get_impl(), protocol, socket, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void assign(const protocol_type& protocol, const native_handle_type& socket, std::error_code& ec)
+  {
+    this->get_service().assign(this->get_impl(), protocol, socket, ec);
+  }
+
+  bool is_open() const { return this->get_service().is_open(this->get_impl()); }
+
+  native_handle_type native_handle() const { return this->get_service().native_handle(this->get_impl()); }
+
+  void close()
+  {
+    std::error_code ec;
+    this->get_service().close(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void close(std::error_code& ec) { this->get_service().close(this->get_impl(), ec); }
+
+  // socket 緢͸һ̺ٹر
+  native_handle_type release() { return this->get_service().release(this->get_impl()); }
+
+  void cancel()
+  {
+    std::error_code ec;
+    this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  template <typename SettableSocketOption>
+  void set_option(const SettableSocketOption& option)
+  {
+    std::error_code ec;
+    this->get_service().set_option(this->get_impl(), option, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  template <typename GettableSocketOption>
+  void get_option(GettableSocketOption& option) const
+  {
+    std::error_code ec;
+    this->get_service().get_option(this->get_impl(), option, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void bind(const endpoint_type& endpoint)
+  {
+    std::error_code ec;
+    this->get_service().bind(this->get_impl(), endpoint, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void connect(const endpoint_type& peer)
+  {
+    std::error_code ec;
+    if (!is_open()) {
+      this->get_service().open(this->get_impl(), peer.protocol(), ec);
+      if (ec) detail::throw_exception(ec);
+    }
+    this->get_service().connect(this->get_impl(), peer, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void shutdown(shutdown_type what)
+  {
+    std::error_code ec;
+    this->get_service().shutdown(this->get_impl(), what, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  endpoint_type local_endpoint() const
+  {
+    std::error_code ec;
+    endpoint_type endpoint = this->get_service().local_endpoint(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    return endpoint;
+  }
+
+  endpoint_type remote_endpoint() const
+  {
+    std::error_code ec;
+    endpoint_type endpoint = this->get_service().remote_endpoint(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    return endpoint;
+  }
+
+  std::size_t send(const const_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().send(this->get_impl(), buffer, 0, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t send(const const_buffer& buffer, const ancillary& anc, std::error_code& ec)
+  {
+    return this->get_service().send(this->get_impl(), buffer, &anc, ec);
+  }
+
+  std::size_t send(const const_buffer& buffer, const ancillary& anc)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().send(this->get_impl(), buffer, &anc, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t receive(const mutable_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().receive(this->get_impl(), buffer, 0, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t receive(const mutable_buffer& buffer, ancillary& anc, std::error_code& ec)
+  {
+    return this->get_service().receive(this->get_impl(), buffer, &anc, ec);
+  }
+
+  std::size_t receive(const mutable_buffer& buffer, ancillary& anc)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().receive(this->get_impl(), buffer, &anc, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t send_to(const const_buffer& buffer, const endpoint_type& destination)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().send_to(this->get_impl(), buffer, destination, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t receive_from(const mutable_buffer& buffer, endpoint_type& sender)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().receive_from(this->get_impl(), buffer, sender, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  template <typename ConnectHandler>
+  typename detail::async_result_helper<ConnectHandler, void(std::error_code)>::result_type async_connect(
+      const endpoint_type& peer, ConnectHandler&& handler)
+  {
+    std::error_code open_ec;
+    if (!is_open()) this->get_service().open(this->get_impl(), peer.protocol(), open_ec);
+    async_completion<ConnectHandler, void(std::error_code)> init(handler);
+    this->get_service().async_connect(this->get_impl(), peer, init.handler_, open_ec);
+    return init.result_.get();
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type async_send(
+      const const_buffer& buffer, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_send(this->get_impl(), buffer, init.handler_);
+    return init.result_.get();
+  }
+
+  // ͬʱ/ƾ֤ ancڷʱ
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type async_send(
+      const const_buffer& buffer, const ancillary& anc, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_sendmsg(this->get_impl(), buffer, 0, &anc, init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type async_send_to(
+      const const_buffer& buffer, const endpoint_type& destination, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_sendmsg(this->get_impl(), buffer, &destination, 0, init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type async_receive(
+      const mutable_buffer& buffer, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_receive(this->get_impl(), buffer, init.handler_);
+    return init.result_.get();
+  }
+
+  // ͬʱ/ƾ֤ ancǰ뱣Ч
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type async_receive(
+      const mutable_buffer& buffer, ancillary& anc, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_recvmsg(this->get_impl(), buffer, 0, &anc, init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type
+  async_receive_from(const mutable_buffer& buffer, endpoint_type& sender, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_recvmsg(this->get_impl(), buffer, &sender, 0, init.handler_);
+    return init.result_.get();
+  }
+
+  // ӿ async_read_untilϲʹ
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type
+  async_read_some(const mutable_buffer& buffer, ReadHandler&& handler)
+  {
+    return async_receive(buffer, std::forward<ReadHandler>(handler));
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type
+  async_write_some(const const_buffer& buffer, WriteHandler&& handler)
+  {
+    return async_send(buffer, std::forward<WriteHandler>(handler));
+  }
+
+  template <typename WaitHandler>
+  typename detail::async_result_helper<WaitHandler, void(std::error_code)>::result_type async_wait(
+      wait_type w, WaitHandler&& handler)
+  {
+    async_completion<WaitHandler, void(std::error_code)> init(handler);
+    this->get_service().async_wait(this->get_impl(), w, init.handler_);
+    return init.result_.get();
+  }
+};
+
+// socket Ҳassignһյļ
+template <typename Protocol>
+class basic_local_acceptor : public basic_io_object<detail::reactive_socket_service<Protocol>>, public socket_base
+{
+  using service_type = detail::reactive_socket_service<Protocol>;
+
+ public:
+  using protocol_type = Protocol;
+  using endpoint_type = typename Protocol::endpoint;
+  using native_handle_type = typename service_type::native_handle_type;
+
+  explicit basic_local_acceptor(io_context& ioc) : basic_io_object<service_type>(ioc) {}
+
+  // 򿪡󶨲ʼ
+  basic_local_acceptor(io_context& ioc, const endpoint_type& endpoint, int backlog = max_listen_connections)
+      : basic_io_object<service_type>(ioc)
+  {
+    std::error_code ec;
+    this->get_service().open(this->get_impl(), endpoint.protocol(), ec);
+    if (ec) detail::throw_exception(ec);
+    this->get_service().bind(this->get_impl(), endpoint, ec);
+    if (ec) detail::throw_exception(ec);
+    this->get_service().listen(this->get_impl(), backlog, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  ~basic_local_acceptor() {}
+
+  void assign(const protocol_type& protocol, const native_handle_type& socket)
+  {
+    std::error_code ec;
+    this->get_service().assign(this->get_impl(), protocol, socket, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  bool is_open() const { return this->get_service().is_open(this->get_impl()); }
+
+  native_handle_type native_handle() const { return this->get_service().native_handle(this->get_impl()); }
+
+  void close()
+  {
+    std::error_code ec;
+    this->get_service().close(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  native_handle_type release() { return this->get_service().release(this->get_impl()); }
+
+  void cancel()
+  {
+    std::error_code ec;
+    this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  endpoint_type local_endpoint() const
+  {
+    std::error_code ec;
+    endpoint_type endpoint = this->get_service().local_endpoint(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+    return endpoint;
+  }
+
+  void accept(basic_local_socket<Protocol>& peer)
+  {
+    std::error_code ec;
+    this->get_service().accept(this->get_impl(), peer, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  template <typename AcceptHandler>
+  typename detail::async_result_helper<AcceptHandler, void(std::error_code)>::result_type async_accept(
+      basic_local_socket<Protocol>& peer, AcceptHandler&& handler)
+  {
+    async_completion<AcceptHandler, void(std::error_code)> init(handler);
+    this->get_service().async_accept(this->get_impl(), peer, init.handler_);
+    return init.result_.get();
+  }
+};
+
+// socketpairһӵsocket
+template <typename Protocol>
+void connect_pair(basic_local_socket<Protocol>& socket1, basic_local_socket<Protocol>& socket2, std::error_code& ec)
+{
+  Protocol protocol;
+  int sv[2];
+  if (!detail::socket_ops::socketpair(protocol.family(), protocol.type(), protocol.protocol(), sv, ec)) {
+    return;
+  }
+  socket1.assign(protocol, sv[0], ec);
+  if (ec) {
+    ::close(sv[0]);
+    ::close(sv[1]);
+    return;
+  }
+  socket2.assign(protocol, sv[1], ec);
+  if (ec) {
+    socket1.close();
+    ::close(sv[1]);
+  }
+}
+
+template <typename Protocol>
+void connect_pair(basic_local_socket<Protocol>& socket1, basic_local_socket<Protocol>& socket2)
+{
+  std::error_code ec;
+  connect_pair(socket1, socket2, ec);
+  if (ec) detail::throw_exception(ec);
+}
+}  // namespace boost::asio::local
+#endif  // !BOOST_ASIO_LOCAL_SOCKET_HPP
@@ -0,0 +1,11 @@
+#ifndef BOOST_ASIO_PERIODIC_TIMER_HPP
+#define BOOST_ASIO_PERIODIC_TIMER_HPP
+
+#include <chrono>
+#include "basic_periodic_timer.hpp"
+
+namespace boost::asio {
+using periodic_timer = basic_periodic_timer<std::chrono::steady_clock>;
+}
+
+#endif  // !BOOST_ASIO_PERIODIC_TIMER_HPP
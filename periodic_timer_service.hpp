@@ -0,0 +1,219 @@
+#ifndef BOOST_ASIO_DETAIL_PERIODIC_TIMER_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_PERIODIC_TIMER_SERVICE_HPP
+
+#include <functional>
+#include "detail_deadline_timer_service.hpp"
+#include "epoll_reactor.hpp"
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "io_context.hpp"
+#include "mutex.hpp"
+#include "service_registry_helpers.hpp"
+#include "wait_op.hpp"
+
+namespace boost::asio::detail {
+
+// ڶʱ
+// һstartֻһÿεںͬһʱ·ŻضʱУٷͿhandler
+// cancel·Żضк;ͷŲmutex_½Уcancelǰᱻ߳ͷ
+template <typename Time_Traits, typename TimerQueue = default_timer_queue<Time_Traits>>
+class periodic_timer_service : public service_base<periodic_timer_service<Time_Traits, TimerQueue>>
+{
+ public:
+  using time_point = typename Time_Traits::time_point;
+  using duration = typename Time_Traits::duration;
+
+  // tickô
+  enum missed_tick_policy
+  {
+    skip,     // ϲһλص ticksΪ֮ԭʱ
+    catch_up  //  ÿλصticksΪ1
+  };
+
+  class periodic_op;
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    duration period_;
+    missed_tick_policy policy_;
+    periodic_op* op_;  // еĲ
+  };
+
+  periodic_timer_service(io_context& ioc)
+      : service_base<periodic_timer_service<Time_Traits, TimerQueue>>(ioc), scheduler_(use_service<epoll_reactor>(ioc))
+  {
+    scheduler_.init_task();
+    scheduler_.add_timer_queue(timer_queue_);
+  }
+
+  ~periodic_timer_service() { scheduler_.remove_timer_queue(timer_queue_); }
+
+  void shutdown() {}
+
+  void construct(impl_type& impl)
+  {
+    impl.period_ = duration::zero();
+    impl.policy_ = skip;
+    impl.op_ = 0;
+  }
+
+  void destroy(impl_type& impl)
+  {
+    std::error_code ec;
+    cancel(impl, ec);
+  }
+
+  duration period(const impl_type& impl) const { return impl.period_; }
+  void set_period(impl_type& impl, const duration& period) { impl.period_ = period; }
+
+  missed_tick_policy policy(const impl_type& impl) const { return impl.policy_; }
+  void set_policy(impl_type& impl, missed_tick_policy policy) { impl.policy_ = policy; }
+
+  bool running(const impl_type& impl) const { return impl.op_ != 0; }
+
+  // ֹͣ handlerһoperation_abortedص
+  std::size_t cancel(impl_type& impl, std::error_code& ec)
+  {
+    ec = std::error_code();
+    periodic_op* op = impl.op_;
+    if (!op) {
+      return 0;
+    }
+    impl.op_ = 0;
+    mutex::scoped_lock lock(mutex_);
+    op->cancelled_ = true;
+    scheduler_.cancel_timer(timer_queue_, op->timer_data_);
+    return 1;
+  }
+
+  // һfirst ֮ÿperiodһ handler: void(std::error_code, std::size_t ticks)
+  template <typename Handler>
+  void async_start(impl_type& impl, const time_point& first, Handler& handler, std::error_code& ec)
+  {
+    if (impl.period_ <= duration::zero()) {
+      ec = std::error_code(EINVAL, std::generic_category());
+      return;
+    }
+    cancel(impl, ec);
+
+    using op = periodic_handler<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(this, first, impl.period_, impl.policy_, handler);
+    impl.op_ = p.p;
+    schedule(p.p);
+    p.v = p.p = 0;
+  }
+
+  // ʱеڲ timer_data_ŲߣʱٺҲһλص
+  class periodic_op : public wait_op
+  {
+   public:
+    periodic_op(periodic_timer_service* service, const time_point& first, const duration& period,
+                missed_tick_policy policy, func_type complete_func)
+        : wait_op(complete_func), service_(service), next_(first), period_(period), policy_(policy), cancelled_(false)
+    {}
+
+   protected:
+    // һεʱ رλصӦ
+    std::size_t advance()
+    {
+      std::size_t ticks = 1;
+      next_ = Time_Traits::add(next_, period_);
+      if (policy_ == skip) {
+        time_point now = Time_Traits::now();
+        if (!Time_Traits::less_than(now, next_)) {
+          std::size_t missed = static_cast<std::size_t>(Time_Traits::subtract(now, next_) / period_) + 1;
+          next_ = Time_Traits::add(next_, period_ * missed);
+          ticks += missed;
+        }
+      }
+      return ticks;
+    }
+
+    // εǷҪص ȡʱһλصͷ
+    bool active()
+    {
+      mutex::scoped_lock lock(service_->mutex_);
+      return !ec_ && !cancelled_;
+    }
+
+    // صڼûбȡʱ·Żضʱ
+    bool reschedule()
+    {
+      mutex::scoped_lock lock(service_->mutex_);
+      if (cancelled_) {
+        return false;
+      }
+      service_->schedule(this);
+      return true;
+    }
+
+   private:
+    friend class periodic_timer_service;
+
+    periodic_timer_service* service_;
+    typename TimerQueue::per_timer_data timer_data_;
+    time_point next_;  // һεʱ periodۼӣܻصӳӰ
+    duration period_;
+    missed_tick_policy policy_;
+
+    bool cancelled_;  // servicemutex_
+  };
+
+  template <typename Handler>
+  class periodic_handler : public periodic_op
+  {
+   public:
+    BOOST_ASIO_DEFINE_HANDLER_PTR(periodic_handler);
+
+    periodic_handler(periodic_timer_service* service, const time_point& first, const duration& period,
+                     missed_tick_policy policy, Handler& handler)
+        : periodic_op(service, first, period, policy, &periodic_handler::do_complete), handler_(std::move(handler))
+    {
+      handler_work<Handler>::start(handler_);
+    }
+
+    static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+    {
+      periodic_handler* o(static_cast<periodic_handler*>(base));
+      if (owner && o->active()) {
+        // ԭصhandler ҲͷŲ
+        o->record_queue_delay();
+        std::size_t ticks = o->advance();
+        handler_work<Handler>::start(o->handler_);
+        {
+          handler_work<Handler> w(o->handler_);
+          fenced_block b(fenced_block::half);
+          w.complate(std::bind(std::ref(o->handler_), std::error_code(), ticks), o->handler_);
+        }
+        if (o->reschedule()) {
+          return;
+        }
+      }
+
+      ptr p = {std::addressof(o->handler_), o, o};
+      handler_work<Handler> w(o->handler_);
+
+      Handler handler(std::move(o->handler_));
+      std::error_code ec(error_code::operation_aborted);
+      p.reset();
+      if (owner) {
+        fenced_block b(fenced_block::half);
+        w.complate(std::bind(handler, ec, std::size_t(0)), handler);
+      }
+    }
+
+   private:
+    Handler handler_;
+  };
+
+ private:
+  void schedule(periodic_op* op) { scheduler_.schedule_timer(timer_queue_, op->next_, op->timer_data_, op); }
+
+  TimerQueue timer_queue_;
+  epoll_reactor& scheduler_;
+  mutex mutex_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_PERIODIC_TIMER_SERVICE_HPP
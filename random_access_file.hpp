@@ -0,0 +1,65 @@
+#ifndef BOOST_ASIO_RANDOM_ACCESS_FILE_HPP
+#define BOOST_ASIO_RANDOM_ACCESS_FILE_HPP
+
+#include "async_result.hpp"
+#include "basic_file.hpp"
+
+namespace boost::asio {
+
+// ƫƶдļ ͬʱ
+class random_access_file : public basic_file
+{
+ public:
+  explicit random_access_file(io_context& ioc) : basic_file(ioc) {}
+
+  random_access_file(io_context& ioc, const std::string& path, flags open_flags) : basic_file(ioc)
+  {
+    open(path, open_flags);
+  }
+
+  std::size_t read_some_at(std::uint64_t offset, const mutable_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().read_some_at(this->get_impl(), offset, buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t read_some_at(std::uint64_t offset, const mutable_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().read_some_at(this->get_impl(), offset, buffer, ec);
+  }
+
+  std::size_t write_some_at(std::uint64_t offset, const const_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().write_some_at(this->get_impl(), offset, buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t write_some_at(std::uint64_t offset, const const_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().write_some_at(this->get_impl(), offset, buffer, ec);
+  }
+
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type
+  async_read_some_at(std::uint64_t offset, const mutable_buffer& buffer, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_read_some_at(this->get_impl(), offset, buffer, init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type
+  async_write_some_at(std::uint64_t offset, const const_buffer& buffer, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_write_some_at(this->get_impl(), offset, buffer, init.handler_);
+    return init.result_.get();
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_RANDOM_ACCESS_FILE_HPP
@@ -0,0 +1,199 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_DESCRIPTOR_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_DESCRIPTOR_SERVICE_HPP
+
+#include "buffer_pool.hpp"
+#include "descriptor_ops.hpp"
+#include "descriptor_read_op.hpp"
+#include "descriptor_write_op.hpp"
+#include "epoll_reactor.hpp"
+#include "io_context.hpp"
+#include "reactive_wait_op.hpp"
+#include "service_registry_helpers.hpp"
+
+namespace boost::asio::detail {
+//  Ѷдҵepoll_reactor
+class reactive_descriptor_service : public service_base<reactive_descriptor_service>
+{
+ public:
+  using native_handle_type = int;
+
+  enum wait_type
+  {
+    wait_read = epoll_reactor::read_op,
+    wait_write = epoll_reactor::write_op,
+    wait_error = epoll_reactor::except_op
+  };
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    int descriptor_;
+    epoll_reactor::ptr_descriptor_data reactor_data_;
+  };
+
+  reactive_descriptor_service(io_context& ioc)
+      : service_base<reactive_descriptor_service>(ioc),
+        reactor_(use_service<epoll_reactor>(ioc)),
+        pool_(use_service<buffer_pool>(ioc))
+  {
+    reactor_.init_task();
+  }
+
+  void shutdown() {}
+
+  void construct(impl_type& impl)
+  {
+    impl.descriptor_ = -1;
+    impl.reactor_data_ = 0;
+  }
+
+  void move_construct(impl_type& impl, impl_type& other_impl)
+  {
+    impl.descriptor_ = other_impl.descriptor_;
+    other_impl.descriptor_ = -1;
+    reactor_.move_descriptor(impl.descriptor_, impl.reactor_data_, other_impl.reactor_data_);
+  }
+
+  void move_assign(impl_type& impl, reactive_descriptor_service& other_service, impl_type& other_impl)
+  {
+    destroy(impl);
+    impl.descriptor_ = other_impl.descriptor_;
+    other_impl.descriptor_ = -1;
+    other_service.reactor_.move_descriptor(impl.descriptor_, impl.reactor_data_, other_impl.reactor_data_);
+  }
+
+  void destroy(impl_type& impl)
+  {
+    if (is_open(impl)) {
+      reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_, true);
+      std::error_code ignored;
+      descriptor_ops::close(impl.descriptor_, ignored);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.descriptor_ = -1;
+    }
+  }
+
+  // ӹһѴ򿪵 Ϊעᵽreactor
+  void assign(impl_type& impl, const native_handle_type& descriptor, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    if (!descriptor_ops::set_non_blocking(descriptor, true, ec)) {
+      return;
+    }
+    if (int err = reactor_.register_descriptor(descriptor, impl.reactor_data_)) {
+      ec = std::error_code(err, std::generic_category());
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      return;
+    }
+    impl.descriptor_ = descriptor;
+    ec = std::error_code();
+  }
+
+  bool is_open(const impl_type& impl) const { return impl.descriptor_ != -1; }
+
+  native_handle_type native_handle(const impl_type& impl) const { return impl.descriptor_; }
+
+  void close(impl_type& impl, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_, true);
+      descriptor_ops::close(impl.descriptor_, ec);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.descriptor_ = -1;
+    } else {
+      ec = std::error_code();
+    }
+  }
+
+  // Ȩ δɵĲoperation_aborted
+  native_handle_type release(impl_type& impl)
+  {
+    native_handle_type descriptor = impl.descriptor_;
+    if (is_open(impl)) {
+      reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_, false);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.descriptor_ = -1;
+    }
+    return descriptor;
+  }
+
+  void cancel(impl_type& impl, std::error_code& ec)
+  {
+    if (!is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    reactor_.cancel_ops(impl.descriptor_, impl.reactor_data_);
+    ec = std::error_code();
+  }
+
+  std::size_t read_some(impl_type& impl, const mutable_buffer& buffer, std::error_code& ec)
+  {
+    return descriptor_ops::sync_read(impl.descriptor_, buffer, ec);
+  }
+
+  std::size_t write_some(impl_type& impl, const const_buffer& buffer, std::error_code& ec)
+  {
+    return descriptor_ops::sync_write(impl.descriptor_, buffer, ec);
+  }
+
+  template <typename Handler>
+  void async_read_some(impl_type& impl, const mutable_buffer& buffer, Handler& handler)
+  {
+    using op = descriptor_read_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.descriptor_, buffer, handler);
+    start_op(impl, epoll_reactor::read_op, p.p, buffer.size() == 0, true);
+    p.v = p.p = 0;
+  }
+
+  // ɻṩ handler: void(std::error_code, pooled_buffer, std::size_t)
+  template <typename Handler>
+  void async_read_some_pooled(impl_type& impl, Handler& handler)
+  {
+    using op = descriptor_pooled_read_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.descriptor_, pool_, handler);
+    start_op(impl, epoll_reactor::read_op, p.p, false, true);
+    p.v = p.p = 0;
+  }
+
+  template <typename Handler>
+  void async_write_some(impl_type& impl, const const_buffer& buffer, Handler& handler)
+  {
+    using op = descriptor_write_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.descriptor_, buffer, handler);
+    start_op(impl, epoll_reactor::write_op, p.p, buffer.size() == 0, true);
+    p.v = p.p = 0;
+  }
+
+  // ȴɶ/д/쳣 д
+  template <typename Handler>
+  void async_wait(impl_type& impl, wait_type w, Handler& handler)
+  {
+    using op = reactive_wait_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(handler);
+    start_op(impl, w, p.p, false, false);
+    p.v = p.p = 0;
+  }
+
+ private:
+  // 㳤ȶдҪȴ ֱ
+  void start_op(impl_type& impl, int op_type, reactor_op* op, bool noop, bool allow_speculative)
+  {
+    if (noop) {
+      reactor_.post_immediate_completion(op, false);
+      return;
+    }
+    reactor_.start_op(op_type, impl.descriptor_, impl.reactor_data_, op, false, allow_speculative);
+  }
+
+  epoll_reactor& reactor_;
+  buffer_pool& pool_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_DESCRIPTOR_SERVICE_HPP
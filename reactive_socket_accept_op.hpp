@@ -0,0 +1,78 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_OP_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "reactor_op.hpp"
+#include "socket_ops.hpp"
+
+namespace boost::asio::detail {
+class reactive_socket_accept_op_base : public reactor_op
+{
+ public:
+  reactive_socket_accept_op_base(int socket, func_type complete_func)
+      : reactor_op(&reactive_socket_accept_op_base::do_perform, complete_func), socket_(socket), new_socket_(-1)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_accept_op_base* o(static_cast<reactive_socket_accept_op_base*>(base));
+    return socket_ops::non_blocking_accept(o->socket_, 0, 0, o->ec_, o->new_socket_) ? done : not_done;
+  }
+
+ protected:
+  int socket_;
+  int new_socket_;
+};
+
+// Ӻhandler̰߳peer ʱر
+template <typename Socket, typename Protocol, typename Handler>
+class reactive_socket_accept_op : public reactive_socket_accept_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_accept_op);
+
+  reactive_socket_accept_op(int socket, Socket& peer, const Protocol& protocol, Handler& handler)
+      : reactive_socket_accept_op_base(socket, &reactive_socket_accept_op::do_complete),
+        peer_(peer),
+        protocol_(protocol),
+        handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_accept_op* o(static_cast<reactive_socket_accept_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    std::error_code ec(o->ec_);
+    if (owner && o->new_socket_ != -1 && !ec) {
+      o->peer_.assign(o->protocol_, o->new_socket_, ec);
+      if (!ec) {
+        o->new_socket_ = -1;
+      }
+    }
+    if (o->new_socket_ != -1) {
+      std::error_code ignored;
+      socket_ops::close(o->new_socket_, ignored);
+    }
+
+    Handler handler(std::move(o->handler_));
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec), handler);
+    }
+  }
+
+ private:
+  Socket& peer_;
+  Protocol protocol_;
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_SOCKET_ACCEPT_OP_HPP
@@ -0,0 +1,60 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_CONNECT_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_CONNECT_OP_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "reactor_op.hpp"
+#include "socket_ops.hpp"
+
+namespace boost::asio::detail {
+class reactive_socket_connect_op_base : public reactor_op
+{
+ public:
+  reactive_socket_connect_op_base(int socket, func_type complete_func)
+      : reactor_op(&reactive_socket_connect_op_base::do_perform, complete_func), socket_(socket)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_connect_op_base* o(static_cast<reactive_socket_connect_op_base*>(base));
+    return socket_ops::non_blocking_connect(o->socket_, o->ec_) ? done : not_done;
+  }
+
+ private:
+  int socket_;
+};
+
+template <typename Handler>
+class reactive_socket_connect_op : public reactive_socket_connect_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_connect_op);
+
+  reactive_socket_connect_op(int socket, Handler& handler)
+      : reactive_socket_connect_op_base(socket, &reactive_socket_connect_op::do_complete), handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_connect_op* o(static_cast<reactive_socket_connect_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_SOCKET_CONNECT_OP_HPP
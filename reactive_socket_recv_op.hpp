@@ -0,0 +1,154 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_RECV_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_RECV_OP_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "local_ancillary.hpp"
+#include "reactor_op.hpp"
+#include "socket_ops.hpp"
+
+namespace boost::asio::detail {
+class reactive_socket_recv_op_base : public reactor_op
+{
+ public:
+  reactive_socket_recv_op_base(int socket, bool is_stream, const mutable_buffer& buffer, func_type complete_func)
+      : reactor_op(&reactive_socket_recv_op_base::do_perform, complete_func),
+        socket_(socket),
+        is_stream_(is_stream),
+        buffer_(buffer)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recv_op_base* o(static_cast<reactive_socket_recv_op_base*>(base));
+    return socket_ops::non_blocking_recvmsg(o->socket_, o->buffer_, o->is_stream_, 0, o->ec_,
+                                            o->bytes_transferred_)
+               ? done
+               : not_done;
+  }
+
+ private:
+  int socket_;
+  bool is_stream_;
+  mutable_buffer buffer_;
+};
+
+template <typename Handler>
+class reactive_socket_recv_op : public reactive_socket_recv_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_op);
+
+  reactive_socket_recv_op(int socket, bool is_stream, const mutable_buffer& buffer, Handler& handler)
+      : reactive_socket_recv_op_base(socket, is_stream, buffer, &reactive_socket_recv_op::do_complete),
+        handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_recv_op* o(static_cast<reactive_socket_recv_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+
+// ͬʱԴַ/ senderancڲǰ뱣Ч
+template <typename Endpoint>
+class reactive_socket_recvmsg_op_base : public reactor_op
+{
+ public:
+  reactive_socket_recvmsg_op_base(int socket, bool is_stream, const mutable_buffer& buffer, Endpoint* sender,
+                                  local::ancillary* anc, func_type complete_func)
+      : reactor_op(&reactive_socket_recvmsg_op_base::do_perform, complete_func),
+        socket_(socket),
+        is_stream_(is_stream),
+        buffer_(buffer),
+        sender_(sender),
+        anc_(anc)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recvmsg_op_base* o(static_cast<reactive_socket_recvmsg_op_base*>(base));
+    socket_ops::message msg;
+    msg.addr_ = o->sender_ ? o->sender_->data() : 0;
+    msg.addr_len_ = o->sender_ ? o->sender_->capacity() : 0;
+    msg.control_ = o->anc_ ? o->control_ : 0;
+    msg.control_len_ = o->anc_ ? sizeof(o->control_) : 0;
+    msg.flags_ = 0;
+    if (!socket_ops::non_blocking_recvmsg(o->socket_, o->buffer_, o->is_stream_, &msg, o->ec_,
+                                          o->bytes_transferred_)) {
+      return not_done;
+    }
+    if (!o->ec_) {
+      if (o->sender_) {
+        o->sender_->resize(msg.addr_len_);
+      }
+      if (o->anc_) {
+        o->anc_->decode(o->control_, msg.control_len_, msg.flags_);
+      }
+    }
+    return done;
+  }
+
+ private:
+  int socket_;
+  bool is_stream_;
+  mutable_buffer buffer_;
+  Endpoint* sender_;
+  local::ancillary* anc_;
+  alignas(cmsghdr) char control_[local::ancillary::control_size];
+};
+
+template <typename Handler, typename Endpoint>
+class reactive_socket_recvmsg_op : public reactive_socket_recvmsg_op_base<Endpoint>
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_recvmsg_op);
+
+  reactive_socket_recvmsg_op(int socket, bool is_stream, const mutable_buffer& buffer, Endpoint* sender,
+                             local::ancillary* anc, Handler& handler)
+      : reactive_socket_recvmsg_op_base<Endpoint>(socket, is_stream, buffer, sender, anc,
+                                                  &reactive_socket_recvmsg_op::do_complete),
+        handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_recvmsg_op* o(static_cast<reactive_socket_recvmsg_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_SOCKET_RECV_OP_HPP
@@ -0,0 +1,119 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_OP_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "local_ancillary.hpp"
+#include "reactor_op.hpp"
+#include "socket_ops.hpp"
+
+namespace boost::asio::detail {
+class reactive_socket_send_op_base : public reactor_op
+{
+ public:
+  reactive_socket_send_op_base(int socket, const const_buffer& buffer, socket_ops::message* msg,
+                               func_type complete_func)
+      : reactor_op(&reactive_socket_send_op_base::do_perform, complete_func),
+        socket_(socket),
+        buffer_(buffer),
+        msg_(msg)
+  {}
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_send_op_base* o(static_cast<reactive_socket_send_op_base*>(base));
+    return socket_ops::non_blocking_sendmsg(o->socket_, o->buffer_, o->msg_, o->ec_, o->bytes_transferred_)
+               ? done
+               : not_done;
+  }
+
+ protected:
+  int socket_;
+  const_buffer buffer_;
+  socket_ops::message* msg_;
+};
+
+template <typename Handler>
+class reactive_socket_send_op : public reactive_socket_send_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_op);
+
+  reactive_socket_send_op(int socket, const const_buffer& buffer, Handler& handler)
+      : reactive_socket_send_op_base(socket, buffer, 0, &reactive_socket_send_op::do_complete),
+        handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_send_op* o(static_cast<reactive_socket_send_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+
+// Ŀĵַ/ݵķ ʱַ븨
+template <typename Handler, typename Endpoint>
+class reactive_socket_sendmsg_op : public reactive_socket_send_op_base
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendmsg_op);
+
+  reactive_socket_sendmsg_op(int socket, const const_buffer& buffer, const Endpoint* destination,
+                             const local::ancillary* anc, Handler& handler)
+      : reactive_socket_send_op_base(socket, buffer, &message_, &reactive_socket_sendmsg_op::do_complete),
+        handler_(std::move(handler))
+  {
+    message_.addr_ = 0;
+    message_.addr_len_ = 0;
+    message_.control_ = control_;
+    message_.control_len_ = anc ? anc->encode(control_) : 0;
+    message_.flags_ = 0;
+    if (destination) {
+      destination_ = *destination;
+      message_.addr_ = destination_.data();
+      message_.addr_len_ = destination_.size();
+    }
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_socket_sendmsg_op* o(static_cast<reactive_socket_sendmsg_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    std::size_t bytes_transferred(o->bytes_transferred_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, bytes_transferred), handler);
+    }
+  }
+
+ private:
+  socket_ops::message message_;
+  Endpoint destination_;
+  alignas(cmsghdr) char control_[local::ancillary::control_size];
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_OP_HPP
@@ -0,0 +1,345 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SERVICE_HPP
+
+#include "epoll_reactor.hpp"
+#include "io_context.hpp"
+#include "local_ancillary.hpp"
+#include "reactive_socket_accept_op.hpp"
+#include "reactive_socket_connect_op.hpp"
+#include "reactive_socket_recv_op.hpp"
+#include "reactive_socket_send_op.hpp"
+#include "reactive_wait_op.hpp"
+#include "service_registry_helpers.hpp"
+#include "socket_ops.hpp"
+
+namespace boost::asio::detail {
+// socket reactive_descriptor_serviceһѲҵepoll_reactor
+template <typename Protocol>
+class reactive_socket_service : public service_base<reactive_socket_service<Protocol>>
+{
+ public:
+  using protocol_type = Protocol;
+  using endpoint_type = typename Protocol::endpoint;
+  using native_handle_type = int;
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    int socket_;
+    bool is_stream_;
+    protocol_type protocol_;
+    epoll_reactor::ptr_descriptor_data reactor_data_;
+  };
+
+  reactive_socket_service(io_context& ioc)
+      : service_base<reactive_socket_service<Protocol>>(ioc), reactor_(use_service<epoll_reactor>(ioc))
+  {
+    reactor_.init_task();
+  }
+
+  void shutdown() {}
+
+  void construct(impl_type& impl)
+  {
+    impl.socket_ = -1;
+    impl.is_stream_ = false;
+    impl.reactor_data_ = 0;
+  }
+
+  void move_construct(impl_type& impl, impl_type& other_impl)
+  {
+    impl.socket_ = other_impl.socket_;
+    other_impl.socket_ = -1;
+    impl.is_stream_ = other_impl.is_stream_;
+    impl.protocol_ = other_impl.protocol_;
+    reactor_.move_descriptor(impl.socket_, impl.reactor_data_, other_impl.reactor_data_);
+  }
+
+  void move_assign(impl_type& impl, reactive_socket_service& other_service, impl_type& other_impl)
+  {
+    destroy(impl);
+    move_construct(impl, other_impl);
+  }
+
+  void destroy(impl_type& impl)
+  {
+    std::error_code ignored;
+    close(impl, ignored);
+  }
+
+  void open(impl_type& impl, const protocol_type& protocol, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    int s = socket_ops::socket(protocol.family(), protocol.type(), protocol.protocol(), ec);
+    if (s < 0) {
+      return;
+    }
+    assign(impl, protocol, s, ec);
+    if (ec) {
+      std::error_code ignored;
+      socket_ops::close(s, ignored);
+    }
+  }
+
+  // ӹѴ򿪵socket ͨSCM_RIGHTSյļsocket
+  void assign(impl_type& impl, const protocol_type& protocol, const native_handle_type& socket, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    if (!descriptor_ops::set_non_blocking(socket, true, ec)) {
+      return;
+    }
+    if (int err = reactor_.register_descriptor(socket, impl.reactor_data_)) {
+      ec = std::error_code(err, std::generic_category());
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      return;
+    }
+    impl.socket_ = socket;
+    impl.is_stream_ = protocol.type() == SOCK_STREAM;
+    impl.protocol_ = protocol;
+    ec = std::error_code();
+  }
+
+  bool is_open(const impl_type& impl) const { return impl.socket_ != -1; }
+
+  native_handle_type native_handle(const impl_type& impl) const { return impl.socket_; }
+
+  void close(impl_type& impl, std::error_code& ec)
+  {
+    if (is_open(impl)) {
+      reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, true);
+      socket_ops::close(impl.socket_, ec);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.socket_ = -1;
+    } else {
+      ec = std::error_code();
+    }
+  }
+
+  native_handle_type release(impl_type& impl)
+  {
+    native_handle_type socket = impl.socket_;
+    if (is_open(impl)) {
+      reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      impl.socket_ = -1;
+    }
+    return socket;
+  }
+
+  void cancel(impl_type& impl, std::error_code& ec)
+  {
+    if (!is_open(impl)) {
+      ec = std::error_code(EBADF, std::generic_category());
+      return;
+    }
+    reactor_.cancel_ops(impl.socket_, impl.reactor_data_);
+    ec = std::error_code();
+  }
+
+  template <typename Option>
+  void set_option(impl_type& impl, const Option& option, std::error_code& ec)
+  {
+    socket_ops::setsockopt(impl.socket_, option.level(), option.name(), option.data(), option.size(), ec);
+  }
+
+  template <typename Option>
+  void get_option(const impl_type& impl, Option& option, std::error_code& ec) const
+  {
+    socklen_t size = option.size();
+    socket_ops::getsockopt(impl.socket_, option.level(), option.name(), option.data(), &size, ec);
+  }
+
+  void bind(impl_type& impl, const endpoint_type& endpoint, std::error_code& ec)
+  {
+    socket_ops::bind(impl.socket_, endpoint.data(), endpoint.size(), ec);
+  }
+
+  void listen(impl_type& impl, int backlog, std::error_code& ec) { socket_ops::listen(impl.socket_, backlog, ec); }
+
+  void shutdown(impl_type& impl, int how, std::error_code& ec) { socket_ops::shutdown(impl.socket_, how, ec); }
+
+  endpoint_type local_endpoint(const impl_type& impl, std::error_code& ec) const
+  {
+    endpoint_type endpoint;
+    socklen_t size = endpoint.capacity();
+    if (socket_ops::getsockname(impl.socket_, endpoint.data(), &size, ec)) {
+      endpoint.resize(size);
+    }
+    return endpoint;
+  }
+
+  endpoint_type remote_endpoint(const impl_type& impl, std::error_code& ec) const
+  {
+    endpoint_type endpoint;
+    socklen_t size = endpoint.capacity();
+    if (socket_ops::getpeername(impl.socket_, endpoint.data(), &size, ec)) {
+      endpoint.resize(size);
+    }
+    return endpoint;
+  }
+
+  void connect(impl_type& impl, const endpoint_type& peer, std::error_code& ec)
+  {
+    socket_ops::sync_connect(impl.socket_, peer.data(), peer.size(), ec);
+  }
+
+  template <typename Socket>
+  void accept(impl_type& impl, Socket& peer, std::error_code& ec)
+  {
+    int new_socket = socket_ops::sync_accept(impl.socket_, 0, 0, ec);
+    if (new_socket >= 0) {
+      peer.assign(impl.protocol_, new_socket, ec);
+      if (ec) {
+        std::error_code ignored;
+        socket_ops::close(new_socket, ignored);
+      }
+    }
+  }
+
+  std::size_t send(impl_type& impl, const const_buffer& buffer, const local::ancillary* anc, std::error_code& ec)
+  {
+    alignas(cmsghdr) char control[local::ancillary::control_size];
+    socket_ops::message msg = {0, 0, control, anc ? anc->encode(control) : 0, 0};
+    return socket_ops::sync_sendmsg(impl.socket_, buffer, &msg, ec);
+  }
+
+  std::size_t send_to(impl_type& impl, const const_buffer& buffer, const endpoint_type& destination,
+                      std::error_code& ec)
+  {
+    socket_ops::message msg = {const_cast<void*>(destination.data()), destination.size(), 0, 0, 0};
+    return socket_ops::sync_sendmsg(impl.socket_, buffer, &msg, ec);
+  }
+
+  std::size_t receive(impl_type& impl, const mutable_buffer& buffer, local::ancillary* anc, std::error_code& ec)
+  {
+    alignas(cmsghdr) char control[local::ancillary::control_size];
+    socket_ops::message msg = {0, 0, anc ? control : 0, anc ? sizeof(control) : 0, 0};
+    std::size_t n = socket_ops::sync_recvmsg(impl.socket_, buffer, impl.is_stream_, &msg, ec);
+    if (!ec && anc) {
+      anc->decode(control, msg.control_len_, msg.flags_);
+    }
+    return n;
+  }
+
+  std::size_t receive_from(impl_type& impl, const mutable_buffer& buffer, endpoint_type& sender,
+                           std::error_code& ec)
+  {
+    socket_ops::message msg = {sender.data(), sender.capacity(), 0, 0, 0};
+    std::size_t n = socket_ops::sync_recvmsg(impl.socket_, buffer, impl.is_stream_, &msg, ec);
+    if (!ec) {
+      sender.resize(msg.addr_len_);
+    }
+    return n;
+  }
+
+  template <typename Handler>
+  void async_connect(impl_type& impl, const endpoint_type& peer, Handler& handler,
+                     const std::error_code& open_ec = std::error_code())
+  {
+    using op = reactive_socket_connect_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, handler);
+    // ÷׽ʧʱֱԸô
+    if (open_ec) {
+      p.p->ec_ = open_ec;
+      reactor_.post_immediate_completion(p.p, false);
+    } else if (impl.socket_ == -1) {
+      p.p->ec_ = std::error_code(EBADF, std::generic_category());
+      reactor_.post_immediate_completion(p.p, false);
+    } else if (socket_ops::start_connect(impl.socket_, peer.data(), peer.size(), p.p->ec_)) {
+      reactor_.post_immediate_completion(p.p, false);
+    } else {
+      reactor_.start_op(epoll_reactor::connect_op, impl.socket_, impl.reactor_data_, p.p, false, false);
+    }
+    p.v = p.p = 0;
+  }
+
+  template <typename Socket, typename Handler>
+  void async_accept(impl_type& impl, Socket& peer, Handler& handler)
+  {
+    using op = reactive_socket_accept_op<Socket, Protocol, Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, peer, impl.protocol_, handler);
+    if (peer.is_open()) {
+      p.p->ec_ = std::error_code(EISCONN, std::generic_category());
+      reactor_.post_immediate_completion(p.p, false);
+    } else {
+      reactor_.start_op(epoll_reactor::read_op, impl.socket_, impl.reactor_data_, p.p, false, true);
+    }
+    p.v = p.p = 0;
+  }
+
+  template <typename Handler>
+  void async_send(impl_type& impl, const const_buffer& buffer, Handler& handler)
+  {
+    using op = reactive_socket_send_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, buffer, handler);
+    start_op(impl, epoll_reactor::write_op, p.p, impl.is_stream_ && buffer.size() == 0);
+    p.v = p.p = 0;
+  }
+
+  // destinationancΪ ʱ
+  template <typename Handler>
+  void async_sendmsg(impl_type& impl, const const_buffer& buffer, const endpoint_type* destination,
+                     const local::ancillary* anc, Handler& handler)
+  {
+    using op = reactive_socket_sendmsg_op<Handler, endpoint_type>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, buffer, destination, anc, handler);
+    start_op(impl, epoll_reactor::write_op, p.p, false);
+    p.v = p.p = 0;
+  }
+
+  template <typename Handler>
+  void async_receive(impl_type& impl, const mutable_buffer& buffer, Handler& handler)
+  {
+    using op = reactive_socket_recv_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, impl.is_stream_, buffer, handler);
+    start_op(impl, epoll_reactor::read_op, p.p, impl.is_stream_ && buffer.size() == 0);
+    p.v = p.p = 0;
+  }
+
+  // senderancΪ ǰ뱣Ч
+  template <typename Handler>
+  void async_recvmsg(impl_type& impl, const mutable_buffer& buffer, endpoint_type* sender, local::ancillary* anc,
+                     Handler& handler)
+  {
+    using op = reactive_socket_recvmsg_op<Handler, endpoint_type>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(impl.socket_, impl.is_stream_, buffer, sender, anc, handler);
+    start_op(impl, epoll_reactor::read_op, p.p, false);
+    p.v = p.p = 0;
+  }
+
+  template <typename Handler>
+  void async_wait(impl_type& impl, int w, Handler& handler)
+  {
+    using op = reactive_wait_op<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(handler);
+    reactor_.start_op(w, impl.socket_, impl.reactor_data_, p.p, false, false);
+    p.v = p.p = 0;
+  }
+
+ private:
+  // ʽsocket㳤ȶдֱ
+  void start_op(impl_type& impl, int op_type, reactor_op* op, bool noop)
+  {
+    if (noop) {
+      reactor_.post_immediate_completion(op, false);
+      return;
+    }
+    reactor_.start_op(op_type, impl.socket_, impl.reactor_data_, op, false, true);
+  }
+
+  epoll_reactor& reactor_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SERVICE_HPP
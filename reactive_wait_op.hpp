@@ -0,0 +1,45 @@
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_WAIT_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_WAIT_OP_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "reactor_op.hpp"
+
+namespace boost::asio::detail {
+// ֻȴ κζд
+template <typename Handler>
+class reactive_wait_op : public reactor_op
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_wait_op);
+
+  reactive_wait_op(Handler& handler)
+      : reactor_op(&reactive_wait_op::do_perform, &reactive_wait_op::do_complete), handler_(std::move(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static status do_perform(reactor_op*) { return done; }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    reactive_wait_op* o(static_cast<reactive_wait_op*>(base));
+    ptr p = {std::addressof(o->handler_), o, o};
+    handler_work<Handler> w(o->handler_);
+
+    Handler handler(std::move(o->handler_));
+    std::error_code ec(o->ec_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_REACTIVE_WAIT_OP_HPP
@@ -0,0 +1,117 @@
+#ifndef BOOST_ASIO_READ_UNTIL_HPP
+#define BOOST_ASIO_READ_UNTIL_HPP
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "async_result.hpp"
+#include "buffer.hpp"
+#include "delimiter_search.hpp"
+#include "error_code.hpp"
+
+namespace boost::asio {
+namespace detail {
+
+// async_read_untilϲ async_read_someֱгַָ
+// search_position_¼Ѿɨλãֶֻ֮ɨµֽ
+template <typename AsyncReadStream, typename DynamicBuffer, typename Handler>
+class read_until_delim_op
+{
+ public:
+  read_until_delim_op(AsyncReadStream& stream, DynamicBuffer& buffers, const std::string& delim, Handler& handler)
+      : stream_(stream), buffers_(buffers), delim_(delim), start_(0), search_position_(0), handler_(std::move(handler))
+  {}
+
+  read_until_delim_op(const read_until_delim_op& other) = default;
+  read_until_delim_op(read_until_delim_op&& other) = default;
+
+  void operator()(const std::error_code& ec, std::size_t bytes_transferred, int start = 0)
+  {
+    const std::size_t not_found = (std::numeric_limits<std::size_t>::max)();
+    std::size_t bytes_to_read;
+    switch (start_ = start) {
+      case 1:
+        for (;;) {
+          {
+            const_buffer data = buffers_.data();
+            const char* first = static_cast<const char*>(data.data());
+            const char* last = first + data.size();
+            const char* pos = find_delimiter(first + search_position_, last, delim_.data(), delim_.size());
+            if (pos != last || delim_.empty()) {
+              search_position_ = (pos - first) + delim_.size();
+              bytes_to_read = 0;
+            } else if (buffers_.size() == buffers_.max_size()) {
+              search_position_ = not_found;
+              bytes_to_read = 0;
+            } else {
+              // ָܿԽζ delim_.size()-1ֽ´ɨ
+              std::size_t keep = delim_.size() - 1;
+              search_position_ = data.size() > keep ? data.size() - keep : 0;
+              bytes_to_read = read_size();
+            }
+          }
+
+          // һεʱʹѾҵҲҪһasync_read_some֤handlerڷڵ
+          if (!start && bytes_to_read == 0) {
+            break;
+          }
+          stream_.async_read_some(buffers_.prepare(bytes_to_read), std::move(*this));
+          return;
+          default:
+            buffers_.commit(bytes_transferred);
+            if (ec || bytes_transferred == 0) {
+              break;
+            }
+        }
+
+        const std::error_code result_ec = (search_position_ == not_found) ? error_code::not_found : ec;
+        const std::size_t result_n = (ec || search_position_ == not_found) ? 0 : search_position_;
+        handler_(result_ec, result_n);
+    }
+  }
+
+ private:
+  std::size_t read_size() const
+  {
+    const std::size_t min_size = 512;
+    const std::size_t max_read = 65536;
+    std::size_t size = buffers_.size();
+    std::size_t room = buffers_.capacity() > size ? buffers_.capacity() - size : 0;
+    std::size_t n = room > min_size ? room : min_size;
+    n = n < max_read ? n : max_read;
+    std::size_t limit = buffers_.max_size() - size;
+    return n < limit ? n : limit;
+  }
+
+  AsyncReadStream& stream_;
+  DynamicBuffer& buffers_;
+  std::string delim_;
+  int start_;
+  std::size_t search_position_;
+  Handler handler_;
+};
+}  // namespace detail
+
+// ȡֱbuffersаdelim صΪָڵֽ
+template <typename AsyncReadStream, typename DynamicBuffer, typename ReadHandler>
+typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type async_read_until(
+    AsyncReadStream& s, DynamicBuffer& buffers, std::string_view delim, ReadHandler&& handler)
+{
+  using handler_type =
+      typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::handler_type;
+  async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+
+  detail::read_until_delim_op<AsyncReadStream, DynamicBuffer, std::decay_t<handler_type>>(
+      s, buffers, std::string(delim), init.handler_)(std::error_code(), 0, 1);
+  return init.result_.get();
+}
+
+template <typename AsyncReadStream, typename DynamicBuffer, typename ReadHandler>
+typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type async_read_until(
+    AsyncReadStream& s, DynamicBuffer& buffers, char delim, ReadHandler&& handler)
+{
+  return async_read_until(s, buffers, std::string_view(&delim, 1), std::forward<ReadHandler>(handler));
+}
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_READ_UNTIL_HPP
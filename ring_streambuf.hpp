@@ -0,0 +1,157 @@
+#ifndef BOOST_ASIO_RING_STREAMBUF_HPP
+#define BOOST_ASIO_RING_STREAMBUF_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include "buffer.hpp"
+#include "noncopyable.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+
+// λ ͬһmemfdڴǰӳ
+// ɶ[get_, put_)ģconsumeֻƶλãҪmemmove
+// dynamic bufferӿ: size/max_size/capacity/data/prepare/commit/consume
+class ring_streambuf : private detail::noncopyable
+{
+ public:
+  enum
+  {
+    default_capacity = 64 * 1024
+  };
+
+  explicit ring_streambuf(std::size_t capacity = default_capacity,
+                          std::size_t max_size = (std::numeric_limits<std::size_t>::max)())
+      : base_(0), capacity_(0), get_(0), put_(0), max_size_(max_size)
+  {
+    base_ = map(round_to_page(capacity), capacity_);
+  }
+
+  ~ring_streambuf() { unmap(base_, capacity_); }
+
+  // ɶֽ
+  std::size_t size() const { return put_ - get_; }
+  std::size_t max_size() const { return max_size_; }
+  std::size_t capacity() const { return capacity_; }
+
+  // ɶ
+  const_buffer data() const { return const_buffer(base_ + get_, put_ - get_); }
+
+  // ׼nֽڵĿд ռ䲻ʱ
+  mutable_buffer prepare(std::size_t n)
+  {
+    if (n > max_size_ - size()) {
+      detail::throw_exception(std::length_error("ring_streambuf too long"));
+    }
+    if (n > capacity_ - size()) {
+      grow(size() + n);
+    }
+    return mutable_buffer(base_ + put_, n);
+  }
+
+  // дnֽڱΪɶ
+  void commit(std::size_t n)
+  {
+    std::size_t space = capacity_ - size();
+    put_ += (n < space ? n : space);
+  }
+
+  // nֽ дλö䵽ڶӳʱһһ
+  void consume(std::size_t n)
+  {
+    std::size_t len = size();
+    get_ += (n < len ? n : len);
+    if (get_ >= capacity_) {
+      get_ -= capacity_;
+      put_ -= capacity_;
+    }
+  }
+
+ private:
+  static std::size_t round_to_page(std::size_t n)
+  {
+    std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    if (n == 0) {
+      n = page;
+    }
+    return (n + page - 1) / page * page;
+  }
+
+  static void throw_errno()
+  {
+    std::error_code ec(errno, std::generic_category());
+    detail::throw_exception(ec);
+  }
+
+  // ȱ2ĵַռ䣬ٰmemfdӳ䵽ǰ
+  static char* map(std::size_t capacity, std::size_t& mapped)
+  {
+    int fd = ::memfd_create("ring_streambuf", MFD_CLOEXEC);
+    if (fd < 0) {
+      throw_errno();
+    }
+    if (::ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+      ::close(fd);
+      throw_errno();
+    }
+
+    void* addr = ::mmap(0, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw_errno();
+    }
+
+    char* base = static_cast<char*>(addr);
+    if (::mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        ::mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      int error = errno;
+      ::munmap(addr, capacity * 2);
+      ::close(fd);
+      errno = error;
+      throw_errno();
+    }
+
+    ::close(fd);  // ӳᱣmemfd
+    mapped = capacity;
+    return base;
+  }
+
+  static void unmap(char* base, std::size_t capacity)
+  {
+    if (base) {
+      ::munmap(base, capacity * 2);
+    }
+  }
+
+  // 2 ƿɶݵӳʼλ
+  void grow(std::size_t min_capacity)
+  {
+    std::size_t new_capacity = capacity_;
+    while (new_capacity < min_capacity) {
+      new_capacity *= 2;
+    }
+    std::size_t mapped = 0;
+    char* new_base = map(new_capacity, mapped);
+
+    std::size_t len = size();
+    std::memcpy(new_base, base_ + get_, len);
+    unmap(base_, capacity_);
+
+    base_ = new_base;
+    capacity_ = mapped;
+    get_ = 0;
+    put_ = len;
+  }
+
+  char* base_;
+  std::size_t capacity_;
+  std::size_t get_;
+  std::size_t put_;
+  std::size_t max_size_;
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_RING_STREAMBUF_HPP
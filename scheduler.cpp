@@ -22,6 +22,7 @@ struct scheduler::task_cleanup
     this_thread_->private_outstanding_work = 0;
 
     lock_->lock();
+    this_thread_->running_task = false;
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->task_interrupted_ = true;
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
@@ -54,16 +55,42 @@ struct scheduler::work_cleanup
   thread_info *this_thread_;
 };
 
+// run߳עᵽrunners_˳ʱ׺ͶʣĲת
+struct scheduler::runner_cleanup
+{
+  ~runner_cleanup()
+  {
+    if (!lock_->locked()) {
+      lock_->lock();
+    }
+    scheduler_->runners_[this_thread_->affinity_slot] = 0;
+    this_thread_->affinity_slot = no_thread;
+    this_thread_->affinity_depth = 0;
+    if (!this_thread_->affinity_op_queue.empty()) {
+      scheduler_->op_queue_.push(this_thread_->affinity_op_queue);
+      if (thread_info *idle = scheduler_->pop_idle_thread()) {
+        idle->wakeup_event.signal(*lock_);
+      }
+    }
+  }
+
+  scheduler *scheduler_;
+  mutex::scoped_lock *lock_;
+  thread_info *this_thread_;
+};
+
 scheduler::scheduler(execution_context &ctx, int concurrency_hint)
     : execution_context_service_base<scheduler>(ctx),
       one_thread_(concurrency_hint == 1),
       mutex_(concurrency_hint > 1),
+      idle_threads_(0),
       task_(0),
       task_interrupted_(false),
       outstanding_work_(0),
       stopped_(false),
       shutdown_(false),
-      concurrency_hint_(concurrency_hint)
+      concurrency_hint_(concurrency_hint),
+      affinity_limit_(default_affinity_limit)
 {}
 
 void scheduler::shutdown()
@@ -105,6 +132,10 @@ std::size_t scheduler::run(std::error_code &ec)
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
+  register_runner(this_thread);
+  runner_cleanup on_exit = {this, &lock, &this_thread};
+  (void)on_exit;
+
   std::size_t n = 0;
   for (; do_run_one(lock, this_thread, ec); lock.lock()) {
     if (n != (std::numeric_limits<std::size_t>::max)()) {
@@ -264,7 +295,7 @@ void scheduler::post_deferred_completions(op_queue<operation> &ops)
 {
   if (one_thread_) {
     if (thread_info_base *this_thread = thread_call_stack::contains(this)) {
-      ops.push(static_cast<thread_info *>(this_thread)->private_op_queue);
+      static_cast<thread_info *>(this_thread)->private_op_queue.push(ops);
       return;
     }
   }
@@ -282,7 +313,41 @@ void scheduler::abandon_operations(op_queue<operation> &ops)
 
 std::size_t scheduler::do_run_one(mutex::scoped_lock &lock, thread_info &this_thread, const std::error_code &ec)
 {
+  thread_info *watched = 0;  // һʱȴڼ俴ŵ߳
+  std::size_t watched_slot = 0;
+  std::size_t watched_seen = 0;
   while (!stopped_) {
+    // ŵ߳ڵȴڼûд׺Ͷȡ ִһ
+    operation *o = 0;
+    if (watched) {
+      o = steal_affine(watched_slot, watched, watched_seen);
+      watched = 0;
+    }
+
+    // ׺Ͷ affinity_batchκ󹫹вʱִһι
+    if (!o && !this_thread.affinity_op_queue.empty() &&
+        (this_thread.affinity_run < affinity_batch || op_queue_.empty())) {
+      o = this_thread.affinity_op_queue.front();
+      this_thread.affinity_op_queue.pop();
+      --this_thread.affinity_depth;
+      ++this_thread.affinity_run;
+      ++this_thread.affinity_taken;
+    }
+    if (o) {
+      if (!op_queue_.empty() && !one_thread_) {
+        unlock_and_signal_one(lock);
+      } else {
+        lock.unlock();
+      }
+      work_cleanup on_exit = {this, &lock, &this_thread};
+      (void)on_exit;
+
+      std::size_t task_result = o->task_result_;
+      o->complete(this, ec, task_result);
+      return 1;
+    }
+    this_thread.affinity_run = 0;
+
     if (!op_queue_.empty()) {
       std::cout << "scheduler::do_run_one(): working... pid= " << std::this_thread::get_id() << '\n';
       operation *o = op_queue_.front();
@@ -290,18 +355,29 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock &lock, thread_info &this_th
       bool more_handlers = (!op_queue_.empty());
       if (o == &task_operation_) {  // task op
         task_interrupted_ = more_handlers;
+        bool more_affine = !this_thread.affinity_op_queue.empty();
+        long usec = (more_handlers || more_affine) ? 0 : -1;
+        if (usec) {
+          if (thread_info *victim = find_stalled_runner(this_thread)) {
+            watched = victim;
+            watched_slot = victim->affinity_slot;
+            watched_seen = victim->affinity_taken;
+            usec = steal_delay_usec;
+          }
+        }
+        this_thread.running_task = true;
         if (more_handlers && !one_thread_) {
-          wakeup_event_.unlock_and_signal_one(lock);
+          unlock_and_signal_one(lock);
         } else {
           lock.unlock();
         }
         task_cleanup on_exit = {this, &lock, &this_thread};
         (void)on_exit;
 
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        task_->run(usec, this_thread.private_op_queue);
       } else {
         if (more_handlers && !one_thread_) {
-          wakeup_event_.unlock_and_signal_one(lock);
+          unlock_and_signal_one(lock);
         } else {
           lock.unlock();
         }
@@ -314,14 +390,52 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock &lock, thread_info &this_th
       }
     } else {
       std::cout << "scheduler::do_run_one(): waiting... pid= " << std::this_thread::get_id() << '\n';
-      wakeup_event_.clear(lock);
-      wakeup_event_.wait(lock);
+      // ̵߳׺Ͷлѹʱʱȴ ûнչ
+      thread_info *victim = find_stalled_runner(this_thread);
+      this_thread.wakeup_event.clear(lock);
+      push_idle_thread(this_thread);
+      if (victim) {
+        watched = victim;
+        watched_slot = victim->affinity_slot;
+        watched_seen = victim->affinity_taken;
+        this_thread.wakeup_event.wait_for_usec(lock, steal_delay_usec);
+      } else {
+        this_thread.wakeup_event.wait(lock);
+      }
+      remove_idle_thread(this_thread);
     }
   }
 
   return 0;
 }
 
+// ִд׺Ͷвյrun߳
+scheduler::thread_info *scheduler::find_stalled_runner(thread_info &this_thread)
+{
+  if (one_thread_) {
+    return 0;
+  }
+  for (thread_info *r : runners_) {
+    if (r && r != &this_thread && !r->idle && !r->running_task && !r->affinity_op_queue.empty()) {
+      return r;
+    }
+  }
+  return 0;
+}
+
+// ȴڼvictimûд׺Ͷȡʱȡ߶
+scheduler::operation *scheduler::steal_affine(std::size_t slot, thread_info *victim, std::size_t seen)
+{
+  if (slot >= runners_.size() || runners_[slot] != victim || victim->affinity_taken != seen ||
+      victim->affinity_op_queue.empty()) {
+    return 0;
+  }
+  operation *o = victim->affinity_op_queue.front();
+  victim->affinity_op_queue.pop();
+  --victim->affinity_depth;
+  return o;
+}
+
 std::size_t scheduler::do_wait_one(mutex::scoped_lock &lock, thread_info &this_thread, long usec,
                                    const std::error_code &ec)
 {
@@ -332,8 +446,10 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock &lock, thread_info &this_t
   // 1
   operation *o = op_queue_.front();
   if (o == 0) {
-    wakeup_event_.clear(lock);
-    wakeup_event_.wait_for_usec(lock, usec);
+    this_thread.wakeup_event.clear(lock);
+    push_idle_thread(this_thread);
+    this_thread.wakeup_event.wait_for_usec(lock, usec);
+    remove_idle_thread(this_thread);
     usec = 0;
     o = op_queue_.front();
   }
@@ -344,7 +460,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock &lock, thread_info &this_t
     bool more_handlers = (!op_queue_.empty());
     task_interrupted_ = more_handlers;
     if (more_handlers && !one_thread_) {
-      wakeup_event_.unlock_and_signal_one(lock);
+      unlock_and_signal_one(lock);
     } else {
       lock.unlock();
     }
@@ -357,7 +473,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock &lock, thread_info &this_t
     o = op_queue_.front();
     if (o == &task_operation_) {
       if (!one_thread_) {
-        wakeup_event_.maybe_unlock_and_signal_one(lock);
+        maybe_unlock_and_signal_one(lock);
       }
       return 0;
     }
@@ -373,7 +489,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock &lock, thread_info &this_t
   bool more_handlers = (!op_queue_.empty());
   std::size_t task_result = o->task_result_;
   if (more_handlers && !one_thread_) {
-    wakeup_event_.unlock_and_signal_one(lock);
+    unlock_and_signal_one(lock);
   } else {
     lock.unlock();
   }
@@ -404,7 +520,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock &lock, thread_info &this_t
 
     o = op_queue_.front();
     if (o == &task_operation_) {
-      wakeup_event_.maybe_unlock_and_signal_one(lock);
+      maybe_unlock_and_signal_one(lock);
       return 0;
     }
   }
@@ -436,7 +552,9 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock &lock, thread_info &this_t
 void scheduler::stop_all_threads(mutex::scoped_lock &lock)
 {
   stopped_ = true;
-  wakeup_event_.signal_all(lock);
+  while (thread_info *idle = pop_idle_thread()) {
+    idle->wakeup_event.signal_all(lock);
+  }
   if (!task_interrupted_ && task_) {
     task_interrupted_ = true;
     task_->interrupt();
@@ -445,7 +563,7 @@ void scheduler::stop_all_threads(mutex::scoped_lock &lock)
 
 void scheduler::wake_one_thread_and_unlock(mutex::scoped_lock &lock)
 {
-  if (!wakeup_event_.maybe_unlock_and_signal_one(lock)) {
+  if (!maybe_unlock_and_signal_one(lock)) {
     if (!task_interrupted_ && task_) {
       task_interrupted_ = true;
       task_->interrupt();
@@ -453,5 +571,113 @@ void scheduler::wake_one_thread_and_unlock(mutex::scoped_lock &lock)
     lock.unlock();
   }
 }
+
+void scheduler::unlock_and_signal_one(mutex::scoped_lock &lock)
+{
+  if (thread_info *idle = pop_idle_thread()) {
+    idle->wakeup_event.unlock_and_signal_one(lock);
+  } else {
+    lock.unlock();
+  }
+}
+
+bool scheduler::maybe_unlock_and_signal_one(mutex::scoped_lock &lock)
+{
+  if (thread_info *idle = pop_idle_thread()) {
+    idle->wakeup_event.unlock_and_signal_one(lock);
+    return true;
+  }
+  return false;
+}
+
+// ̺߳ȳ е̻߳
+void scheduler::push_idle_thread(thread_info &this_thread)
+{
+  this_thread.idle = true;
+  this_thread.next_idle = idle_threads_;
+  idle_threads_ = &this_thread;
+}
+
+scheduler::thread_info *scheduler::pop_idle_thread()
+{
+  thread_info *idle = idle_threads_;
+  if (idle) {
+    idle_threads_ = idle->next_idle;
+    idle->next_idle = 0;
+    idle->idle = false;
+  }
+  return idle;
+}
+
+// ʱ̻߳ڿ
+void scheduler::remove_idle_thread(thread_info &this_thread)
+{
+  if (!this_thread.idle) {
+    return;
+  }
+  for (thread_info **p = &idle_threads_; *p; p = &(*p)->next_idle) {
+    if (*p == &this_thread) {
+      *p = this_thread.next_idle;
+      break;
+    }
+  }
+  this_thread.next_idle = 0;
+  this_thread.idle = false;
+}
+
+void scheduler::register_runner(thread_info &this_thread)
+{
+  std::size_t slot = 0;
+  while (slot < runners_.size() && runners_[slot]) {
+    ++slot;
+  }
+  if (slot == runners_.size()) {
+    runners_.push_back(0);
+  }
+  runners_[slot] = &this_thread;
+  this_thread.affinity_slot = slot;
+}
+
+std::size_t scheduler::this_thread_slot()
+{
+  if (thread_info_base *this_thread = thread_call_stack::contains(this)) {
+    return static_cast<thread_info *>(this_thread)->affinity_slot;
+  }
+  return no_thread;
+}
+
+void scheduler::set_affinity_limit(std::size_t limit)
+{
+  mutex::scoped_lock lock(mutex_);
+  affinity_limit_ = limit;
+}
+
+bool scheduler::post_affine(operation *op, std::size_t thread_slot)
+{
+  work_started();
+  mutex::scoped_lock lock(mutex_);
+  thread_info *target = (!one_thread_ && thread_slot < runners_.size()) ? runners_[thread_slot] : 0;
+  if (!target || target->affinity_depth >= affinity_limit_) {
+    op_queue_.push(op);
+    wake_one_thread_and_unlock(lock);
+    return false;
+  }
+
+  target->affinity_op_queue.push(op);
+  ++target->affinity_depth;
+  if (target->idle) {
+    remove_idle_thread(*target);
+    target->wakeup_event.unlock_and_signal_one(lock);
+  } else if (target->running_task) {
+    if (!task_interrupted_ && task_) {
+      task_interrupted_ = true;
+      task_->interrupt();
+    }
+  } else if (target->affinity_depth == 1 && thread_call_stack::contains(this) != target) {
+    // Ŀִ߳ һ̻߳reactor߳̿ţĿ꿨סʱȡ
+    wake_one_thread_and_unlock(lock);
+  }
+  return true;
+}
 }  // namespace boost::asio::detail
 #endif  // !BOOST_ASIO_DETAIL_SCHEDULER_CPP
\ No newline at end of file
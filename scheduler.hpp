@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <vector>
 #include "conditionally_enabled_event.hpp"
 #include "conditionally_enabled_mutex.hpp"
 #include "execution_context.hpp"
@@ -54,6 +55,21 @@ class scheduler : public execution_context_service_base<scheduler>, public threa
 
   int concurrency_hint() const { return concurrency_hint_; }
 
+  // ׺͵: ͶݵΪthread_slotrun̵߳׺ͶУ߳̿ʱ
+  // ̲߳runл׺Ͷaffinity_limitʱ빫Уfalse
+  // Ŀ߳̿һʱ̵߳steal_delay_usec׺Ͷûнչȡһ
+  enum
+  {
+    affinity_batch = 16,  // ִ׺ͶеĴޣִ֮һι
+    default_affinity_limit = 64,
+    steal_delay_usec = 1000
+  };
+  static constexpr std::size_t no_thread = static_cast<std::size_t>(-1);
+
+  bool post_affine(operation *op, std::size_t thread_slot);
+  std::size_t this_thread_slot();  // ǰ̵߳ı runʱΪno_thread
+  void set_affinity_limit(std::size_t limit);
+
  private:
   using mutex = conditionally_enabled_mutex;
   using event = conditionally_enabled_event;
@@ -65,6 +81,15 @@ class scheduler : public execution_context_service_base<scheduler>, public threa
 
   void stop_all_threads(mutex::scoped_lock &lock);
   void wake_one_thread_and_unlock(mutex::scoped_lock &lock);
+  void unlock_and_signal_one(mutex::scoped_lock &lock);
+  bool maybe_unlock_and_signal_one(mutex::scoped_lock &lock);
+
+  void push_idle_thread(thread_info &this_thread);
+  thread_info *pop_idle_thread();
+  void remove_idle_thread(thread_info &this_thread);
+  void register_runner(thread_info &this_thread);
+  thread_info *find_stalled_runner(thread_info &this_thread);
+  operation *steal_affine(std::size_t slot, thread_info *victim, std::size_t seen);
 
   struct task_cleanup;
   friend struct task_cleanup;
@@ -72,9 +97,12 @@ class scheduler : public execution_context_service_base<scheduler>, public threa
   struct work_cleanup;
   friend struct work_cleanup;
 
+  struct runner_cleanup;
+  friend struct runner_cleanup;
+
   const bool one_thread_;
   mutable mutex mutex_;
-  event wakeup_event_;
+  thread_info *idle_threads_;  // ڸwakeup_eventϵȴ߳
 
   epoll_reactor *task_;
 
@@ -89,6 +117,9 @@ class scheduler : public execution_context_service_base<scheduler>, public threa
   bool stopped_;
   bool shutdown_;
   const int concurrency_hint_;
+
+  std::vector<thread_info *> runners_;  // ±꼴̱߳
+  std::size_t affinity_limit_;
 };
 }  // namespace boost::asio::detail
 
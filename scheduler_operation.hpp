@@ -18,7 +18,7 @@ class scheduler_operation
     func_(owner, this, ec, bytes_transferred);
   }
 
-  void destroy() { func_(this, 0, std::error_code(), 0); }
+  void destroy() { func_(0, this, std::error_code(), 0); }
 
  protected:
   friend class scheduler;
@@ -1,6 +1,8 @@
 #ifndef BOOST_ASIO_DETAIL_SCHEDULER_THREAD_INFO_HPP
 #define BOOST_ASIO_DETAIL_SCHEDULER_THREAD_INFO_HPP
 
+#include <cstddef>
+#include "conditionally_enabled_event.hpp"
 #include "op_queue.hpp"
 #include "thread_info_base.hpp"
 
@@ -9,8 +11,32 @@ class scheduler;
 class scheduler_operation;
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info()
+      : private_outstanding_work(0),
+        next_idle(0),
+        idle(false),
+        running_task(false),
+        affinity_slot(static_cast<std::size_t>(-1)),
+        affinity_depth(0),
+        affinity_run(0),
+        affinity_taken(0)
+  {}
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // ʱԼ¼ϵȴԱ
+  conditionally_enabled_event wakeup_event;
+  scheduler_thread_info* next_idle;
+  bool idle;
+  bool running_task;  // ִreactor
+
+  // ׺Ͷ: ߳Ͷݸ̵߳Ĳscheduler::mutex_
+  op_queue<scheduler_operation> affinity_op_queue;
+  std::size_t affinity_slot;   // scheduler::runners_е± δעʱΪ-1
+  std::size_t affinity_depth;  // affinity_op_queueеĲ
+  std::size_t affinity_run;    // ׺ͶȡĴ
+  std::size_t affinity_taken;  // ׺Ͷȡܴ ߳̾ݴжǷס
 };
 }  // namespace boost::asio::detail
-#endif  // !BOOST_ASIO_DETAIL_SCHEDULER_THREAD_INFO_HPP
\ No newline at end of file
+#endif  // !BOOST_ASIO_DETAIL_SCHEDULER_THREAD_INFO_HPP
@@ -0,0 +1,198 @@
+#ifndef BOOST_ASIO_DETAIL_SHARDED_TIMER_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_SHARDED_TIMER_QUEUE_HPP
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include "mutex.hpp"
+#include "timer_queue_base.hpp"
+#include "wait_op.hpp"
+
+namespace boost::asio::detail {
+
+// Ƭʱ ÿƬԼڲ(timer_queue/dary_timer_queue/timing_wheel)
+// ̵߳һʹʱֵһƬʱһεȴʱ̶ڵǰ̵߳ķƬ
+// schedule_timer/cancel_timerֻʱڷƬپreactormutex_
+// ߳ȡʱʱֱƬȡͬģֵµȴ岻
+// reactorзƬĵʱȴ
+template <typename T, typename Queue, std::size_t Shards>
+class sharded_timer_queue : public timer_queue_base
+{
+  static_assert(Shards > 0, "Shards must be positive");
+
+ public:
+  using time_point = typename T::time_point;  // ʱ
+  using duration = typename T::duration;      // ʱ
+
+  // ʱ
+  class per_timer_data
+  {
+   public:
+    per_timer_data() : shard_(Shards) {}
+
+    std::size_t group() const { return data_.group(); }
+    void set_group(std::size_t group) { data_.set_group(group); }
+
+   private:
+    friend class sharded_timer_queue;
+
+    typename Queue::per_timer_data data_;
+    std::size_t shard_;  // Ƭ Shardsʾδ
+  };
+
+  sharded_timer_queue() {}
+
+  // ʱӵƬ falseʾѾر(reactorshutdown)
+  bool enqueue_timer(const time_point& time, per_timer_data& timer, wait_op* op, bool& earliest)
+  {
+    if (timer.shard_ == Shards) {
+      timer.shard_ = this_thread_shard();
+    }
+    shard& s = shards_[timer.shard_];
+    mutex::scoped_lock lock(s.mutex_);
+    if (s.closed_) {
+      earliest = false;
+      return false;
+    }
+    earliest = s.queue_.enqueue_timer(time, timer.data_, op);
+    return true;
+  }
+
+  virtual bool empty() const
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      if (!shards_[i].queue_.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      max_duration = shards_[i].queue_.wait_duration_msec(max_duration);
+    }
+    return max_duration;
+  }
+
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      max_duration = shards_[i].queue_.wait_duration_usec(max_duration);
+    }
+    return max_duration;
+  }
+
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      shards_[i].queue_.get_ready_timers(ops);
+    }
+  }
+
+  // ֻreactor shutdownʱ ֮µĵȴֱ
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      shards_[i].queue_.get_all_timers(ops);
+      shards_[i].closed_ = true;
+    }
+  }
+
+  // ƬԼ¼latenessheap_size ȴʱ乲һݰ̷ֱ߳ͼ
+  virtual void enable_statistics()
+  {
+    if (!queue_delay_) {
+      queue_delay_.reset(new queue_delay_histogram);
+    }
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      shards_[i].queue_.enable_statistics(*queue_delay_);
+    }
+  }
+
+  virtual void merge_statistics(timer_statistics& statistics) const
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      shards_[i].queue_.merge_statistics(statistics);
+    }
+    if (queue_delay_) {
+      queue_delay_->merge_to(statistics.queue_delay);
+    }
+  }
+
+  virtual void reset_statistics()
+  {
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      shards_[i].queue_.reset_statistics();
+    }
+    if (queue_delay_) {
+      queue_delay_->reset();
+    }
+  }
+
+  // ȡʱ ʱƬ
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+                           std::size_t max_cancelled = std::numeric_limits<std::size_t>::max())
+  {
+    if (timer.shard_ == Shards) {
+      return 0;
+    }
+    shard& s = shards_[timer.shard_];
+    mutex::scoped_lock lock(s.mutex_);
+    return s.queue_.cancel_timer(timer.data_, ops, max_cancelled);
+  }
+
+  // ƬȡgroupеĶʱ ÿƬֻһ
+  std::size_t cancel_group(std::size_t group, op_queue<operation>& ops)
+  {
+    std::size_t num_cancelled = 0;
+    for (std::size_t i = 0; i < Shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      num_cancelled += shards_[i].queue_.cancel_group(group, ops);
+    }
+    return num_cancelled;
+  }
+
+  // ƶʱ targetԭеĲѾȡ
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    if (source.shard_ != Shards) {
+      shard& s = shards_[source.shard_];
+      mutex::scoped_lock lock(s.mutex_);
+      s.queue_.move_timer(target.data_, source.data_);
+    }
+    target.shard_ = source.shard_;
+  }
+
+ private:
+  struct alignas(64) shard
+  {
+    shard() : closed_(false) {}
+
+    mutable detail::mutex mutex_;
+    Queue queue_;
+    bool closed_;
+  };
+
+  // ̵߳һεʱƬ
+  static std::size_t this_thread_shard()
+  {
+    static std::atomic<std::size_t> next_shard(0);
+    thread_local std::size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % Shards;
+    return index;
+  }
+
+  shard shards_[Shards];
+  std::unique_ptr<queue_delay_histogram> queue_delay_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_SHARDED_TIMER_QUEUE_HPP
@@ -25,7 +25,7 @@ class signal_blocker : private noncopyable
   void unblock()
   {
     if (blocked_) {
-      blocked_ = (::pthread_sigmask(SIG_BLOCK, &old_mask_, 0) != 0);  // 
+      blocked_ = (::pthread_sigmask(SIG_SETMASK, &old_mask_, 0) != 0);  // 
     }
   }
 
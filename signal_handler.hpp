@@ -0,0 +1,42 @@
+#ifndef BOOST_ASIO_DETAIL_SIGNAL_HANDLER_HPP
+#define BOOST_ASIO_DETAIL_SIGNAL_HANDLER_HPP
+
+#include <functional>
+#include "fenced_block.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "handler_work.hpp"
+#include "signal_op.hpp"
+
+namespace boost::asio::detail {
+template <typename Handler>
+class signal_handler : public signal_op
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(signal_handler);
+
+  signal_handler(Handler& h) : signal_op(&signal_handler::do_complete), handler_(std::move(h))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+  {
+    signal_handler* h(static_cast<signal_handler*>(base));
+    ptr p = {std::addressof(h->handler_), h, h};
+    handler_work<Handler> w(h->handler_);
+
+    Handler handler(std::move(h->handler_));
+    std::error_code ec(h->ec_);
+    int signal_number(h->signal_number_);
+    p.reset();
+    if (owner) {
+      fenced_block b(fenced_block::half);
+      w.complate(std::bind(handler, ec, signal_number), handler);
+    }
+  }
+
+ private:
+  Handler handler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_SIGNAL_HANDLER_HPP
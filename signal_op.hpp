@@ -0,0 +1,17 @@
+#ifndef BOOST_ASIO_DETAIL_SIGNAL_OP_HPP
+#define BOOST_ASIO_DETAIL_SIGNAL_OP_HPP
+
+#include "scheduler_operation.hpp"
+
+namespace boost::asio::detail {
+
+class signal_op : public scheduler_operation
+{
+ public:
+  std::error_code ec_;
+  int signal_number_;  // յź
+  signal_op(func_type func) : scheduler_operation(func), signal_number_(0) {}
+};
+
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_SIGNAL_OP_HPP
@@ -0,0 +1,80 @@
+#ifndef BOOST_ASIO_SIGNAL_SET_HPP
+#define BOOST_ASIO_SIGNAL_SET_HPP
+
+#include "async_result.hpp"
+#include "basic_io_object.hpp"
+#include "signal_set_service.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio {
+
+// 첽ź handler: void(std::error_code, int signal_number)
+// ûеȴʱźŻᱻ¼һasync_wait
+class signal_set : public basic_io_object<detail::signal_set_service>
+{
+ public:
+  explicit signal_set(io_context& ioc) : basic_io_object<detail::signal_set_service>(ioc) {}
+
+  signal_set(io_context& ioc, int signal_number_1) : basic_io_object<detail::signal_set_service>(ioc)
+  {
+    add(signal_number_1);
+  }
+
+  signal_set(io_context& ioc, int signal_number_1, int signal_number_2)
+      : basic_io_object<detail::signal_set_service>(ioc)
+  {
+    add(signal_number_1);
+    add(signal_number_2);
+  }
+
+  signal_set(io_context& ioc, int signal_number_1, int signal_number_2, int signal_number_3)
+      : basic_io_object<detail::signal_set_service>(ioc)
+  {
+    add(signal_number_1);
+    add(signal_number_2);
+    add(signal_number_3);
+  }
+
+  ~signal_set() {}
+
+  void add(int signal_number)
+  {
+    std::error_code ec;
+    this->get_service().add(this->get_impl(), signal_number, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void add(int signal_number, std::error_code& ec) { this->get_service().add(this->get_impl(), signal_number, ec); }
+
+  void remove(int signal_number)
+  {
+    std::error_code ec;
+    this->get_service().remove(this->get_impl(), signal_number, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void clear()
+  {
+    std::error_code ec;
+    this->get_service().clear(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void cancel()
+  {
+    std::error_code ec;
+    this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  template <typename SignalHandler>
+  typename detail::async_result_helper<SignalHandler, void(std::error_code, int)>::result_type async_wait(
+      SignalHandler&& handler)
+  {
+    async_completion<SignalHandler, void(std::error_code, int)> init(handler);
+    this->get_service().async_wait(this->get_impl(), init.handler_);
+    return init.result_.get();
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_SIGNAL_SET_HPP
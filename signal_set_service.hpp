@@ -0,0 +1,423 @@
+#ifndef BOOST_ASIO_DETAIL_SIGNAL_SET_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_SIGNAL_SET_SERVICE_HPP
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include "epoll_reactor.hpp"
+#include "error_code.hpp"
+#include "io_context.hpp"
+#include "mutex.hpp"
+#include "op_queue.hpp"
+#include "reactor_op.hpp"
+#include "scheduler.hpp"
+#include "service_registry_helpers.hpp"
+#include "signal_handler.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio::detail {
+// źŷ ÿio_contextһsignalfdΪڲעᵽepoll_reactor
+// źŵķַio_contextע˸źŵsignal_set
+// עźڵadd߳б̳߳߳thread_groupʱȫź
+// ûźŵ߳յʱתԼź·̣signalfd
+// ڴκ֮߳ǰ߳Ҫȴźţᾭת
+class signal_set_service : public service_base<signal_set_service>
+{
+ public:
+  enum
+  {
+    max_signal_number = _NSIG
+  };
+
+  class registration
+  {
+   public:
+    registration() : signal_number_(0), queue_(0), undelivered_(0), next_in_table_(0), prev_in_table_(0), next_in_set_(0)
+    {}
+
+   private:
+    friend class signal_set_service;
+    int signal_number_;
+    op_queue<signal_op>* queue_;  // signal_setĵȴ
+    std::size_t undelivered_;     // ûеȴʱյĴ
+    registration* next_in_table_;
+    registration* prev_in_table_;
+    registration* next_in_set_;
+  };
+
+  struct impl_type : private boost::asio::detail::noncopyable
+  {
+    registration* signals_;
+    op_queue<signal_op> queue_;
+  };
+
+  signal_set_service(io_context& ioc)
+      : service_base<signal_set_service>(ioc),
+        scheduler_(use_service<io_context_impl>(ioc)),
+        reactor_(use_service<epoll_reactor>(ioc)),
+        signal_fd_(-1),
+        reactor_data_(0),
+        read_op_(this),
+        next_(0),
+        prev_(0)
+  {
+    reactor_.init_task();
+    for (int i = 0; i < max_signal_number; ++i) {
+      registrations_[i] = 0;
+    }
+
+    sigemptyset(&mask_);
+    signal_fd_ = ::signalfd(-1, &mask_, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd_ < 0) {
+      std::error_code ec(errno, std::generic_category());
+      detail::throw_exception(ec);
+    }
+    reactor_.register_internal_descriptor(epoll_reactor::read_op, signal_fd_, reactor_data_, &read_op_);
+
+    mutex::scoped_lock lock(get_state().mutex_);
+    next_ = get_state().service_list_;
+    if (next_) {
+      next_->prev_ = this;
+    }
+    get_state().service_list_ = this;
+  }
+
+  ~signal_set_service()
+  {
+    if (signal_fd_ != -1) {
+      ::close(signal_fd_);
+    }
+  }
+
+  // reactorƳsignalfd ȫַժ
+  void shutdown()
+  {
+    {
+      mutex::scoped_lock lock(get_state().mutex_);
+      if (get_state().service_list_ == this) {
+        get_state().service_list_ = next_;
+      }
+      if (prev_) {
+        prev_->next_ = next_;
+      }
+      if (next_) {
+        next_->prev_ = prev_;
+      }
+      next_ = prev_ = 0;
+    }
+    reactor_.deregister_internal_descriptor(signal_fd_, reactor_data_);
+    reactor_.cleanup_descriptor_data(reactor_data_);
+
+    op_queue<operation> ops;
+    mutex::scoped_lock lock(get_state().mutex_);
+    for (int i = 0; i < max_signal_number; ++i) {
+      for (registration* reg = registrations_[i]; reg; reg = reg->next_in_table_) {
+        while (signal_op* op = reg->queue_->front()) {
+          reg->queue_->pop();
+          ops.push(op);
+        }
+      }
+    }
+    lock.unlock();
+    scheduler_.abandon_operations(ops);
+  }
+
+  void construct(impl_type& impl) { impl.signals_ = 0; }
+
+  void destroy(impl_type& impl)
+  {
+    std::error_code ignored;
+    clear(impl, ignored);
+    cancel(impl, ignored);
+  }
+
+  void add(impl_type& impl, int signal_number, std::error_code& ec)
+  {
+    if (signal_number <= 0 || signal_number >= max_signal_number || signal_number == SIGKILL ||
+        signal_number == SIGSTOP) {
+      ec = std::error_code(EINVAL, std::generic_category());
+      return;
+    }
+
+    mutex::scoped_lock lock(get_state().mutex_);
+    registration** insertion_point = &impl.signals_;
+    registration* next = impl.signals_;
+    while (next && next->signal_number_ < signal_number) {
+      insertion_point = &next->next_in_set_;
+      next = next->next_in_set_;
+    }
+    if (next && next->signal_number_ == signal_number) {  // Ѿע
+      ec = std::error_code();
+      return;
+    }
+
+    if (registrations_[signal_number] == 0) {
+      sigset_t mask = mask_;
+      sigaddset(&mask, signal_number);
+      if (!update_mask(mask, signal_number, ec)) {
+        return;
+      }
+    }
+
+    registration* new_registration = new registration;
+    new_registration->signal_number_ = signal_number;
+    new_registration->queue_ = &impl.queue_;
+    new_registration->next_in_set_ = next;
+    *insertion_point = new_registration;
+
+    new_registration->next_in_table_ = registrations_[signal_number];
+    if (registrations_[signal_number]) {
+      registrations_[signal_number]->prev_in_table_ = new_registration;
+    }
+    registrations_[signal_number] = new_registration;
+    ec = std::error_code();
+  }
+
+  void remove(impl_type& impl, int signal_number, std::error_code& ec)
+  {
+    if (signal_number <= 0 || signal_number >= max_signal_number) {
+      ec = std::error_code(EINVAL, std::generic_category());
+      return;
+    }
+
+    mutex::scoped_lock lock(get_state().mutex_);
+    registration** deletion_point = &impl.signals_;
+    registration* reg = impl.signals_;
+    while (reg && reg->signal_number_ < signal_number) {
+      deletion_point = &reg->next_in_set_;
+      reg = reg->next_in_set_;
+    }
+    if (reg && reg->signal_number_ == signal_number) {
+      *deletion_point = reg->next_in_set_;
+      unlink(reg);
+      delete reg;
+    }
+    ec = std::error_code();
+  }
+
+  void clear(impl_type& impl, std::error_code& ec)
+  {
+    mutex::scoped_lock lock(get_state().mutex_);
+    while (registration* reg = impl.signals_) {
+      impl.signals_ = reg->next_in_set_;
+      unlink(reg);
+      delete reg;
+    }
+    ec = std::error_code();
+  }
+
+  void cancel(impl_type& impl, std::error_code& ec)
+  {
+    op_queue<operation> ops;
+    {
+      mutex::scoped_lock lock(get_state().mutex_);
+      while (signal_op* op = impl.queue_.front()) {
+        op->ec_ = error_code::operation_aborted;
+        impl.queue_.pop();
+        ops.push(op);
+      }
+    }
+    scheduler_.post_deferred_completions(ops);
+    ec = std::error_code();
+  }
+
+  // δͶݵźʱֱ Ŷӵȴ
+  template <typename Handler>
+  void async_wait(impl_type& impl, Handler& handler)
+  {
+    using op = signal_handler<Handler>;
+    typename op::ptr p = {std::addressof(handler), op::ptr::allocate(handler), 0};
+    p.p = new (p.v) op(handler);
+
+    mutex::scoped_lock lock(get_state().mutex_);
+    for (registration* reg = impl.signals_; reg; reg = reg->next_in_set_) {
+      if (reg->undelivered_ > 0) {
+        --reg->undelivered_;
+        p.p->signal_number_ = reg->signal_number_;
+        lock.unlock();
+        scheduler_.post_immediate_completion(p.p, false);
+        p.v = p.p = 0;
+        return;
+      }
+    }
+    impl.queue_.push(p.p);
+    scheduler_.work_started();
+    p.v = p.p = 0;
+  }
+
+ private:
+  // ȫ״̬ io_contextźŷ
+  struct state
+  {
+    state() : service_list_(0)
+    {
+      for (int i = 0; i < max_signal_number; ++i) {
+        registration_count_[i] = 0;
+        unblock_[i] = false;
+      }
+    }
+    detail::mutex mutex_;
+    signal_set_service* service_list_;
+    std::size_t registration_count_[max_signal_number];  // ע˸źŵķ
+    struct sigaction old_action_[max_signal_number];       // һעǰĴʽ
+    bool unblock_[max_signal_number];                      // һעǰ߳ûź
+    pthread_t blocking_thread_[max_signal_number];         // һע߳
+  };
+
+  static state& get_state()
+  {
+    static state s;
+    return s;
+  }
+
+  // signalfdɶʱź һֱڶ
+  class signal_read_op : public reactor_op
+  {
+   public:
+    signal_read_op(signal_set_service* service)
+        : reactor_op(&signal_read_op::do_perform, &signal_read_op::do_complete), service_(service)
+    {}
+
+    static status do_perform(reactor_op* base)
+    {
+      signal_read_op* o(static_cast<signal_read_op*>(base));
+      signal_set_service* service = o->service_;
+      signalfd_siginfo info[16];
+      for (;;) {
+        ssize_t n = ::read(service->signal_fd_, info, sizeof(info));
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n <= 0) {
+          break;
+        }
+        for (std::size_t i = 0; i < n / sizeof(signalfd_siginfo); ++i) {
+          deliver_signal(static_cast<int>(info[i].ssi_signo));
+        }
+      }
+      return not_done;
+    }
+
+    static void do_complete(void*, operation*, const std::error_code&, std::size_t) {}
+
+   private:
+    signal_set_service* service_;
+  };
+
+  // Ͷݸзע˸źŵsignal_set
+  static void deliver_signal(int signal_number)
+  {
+    mutex::scoped_lock lock(get_state().mutex_);
+    for (signal_set_service* service = get_state().service_list_; service; service = service->next_) {
+      op_queue<operation> ops;
+      for (registration* reg = service->registrations_[signal_number]; reg; reg = reg->next_in_table_) {
+        if (signal_op* op = reg->queue_->front()) {
+          op->signal_number_ = signal_number;
+          reg->queue_->pop();
+          ops.push(op);
+        } else {
+          ++reg->undelivered_;
+        }
+      }
+      service->scheduler_.post_deferred_completions(ops);
+    }
+  }
+
+  // ûźŵִ߳: غ߳źţٷ̶ֱ̣߳signalfd
+  static void forward_signal(int signal_number, siginfo_t*, void* context)
+  {
+    int saved_errno = errno;
+    sigaddset(&static_cast<ucontext_t*>(context)->uc_sigmask, signal_number);
+    ::kill(::getpid(), signal_number);
+    errno = saved_errno;
+  }
+
+  // ߳еĸź signalfdźż
+  // ڵһעʱװת¼ԭĴʽ״̬
+  bool update_mask(const sigset_t& mask, int signal_number, std::error_code& ec)
+  {
+    state& s = get_state();
+    if (s.registration_count_[signal_number] == 0) {
+      struct sigaction action = {};
+      action.sa_sigaction = &signal_set_service::forward_signal;
+      action.sa_flags = SA_SIGINFO | SA_RESTART;
+      sigemptyset(&action.sa_mask);
+      if (::sigaction(signal_number, &action, &s.old_action_[signal_number]) != 0) {
+        ec = std::error_code(errno, std::generic_category());
+        return false;
+      }
+    }
+
+    sigset_t block, old_mask;
+    sigemptyset(&block);
+    sigaddset(&block, signal_number);
+    ::pthread_sigmask(SIG_BLOCK, &block, &old_mask);
+    if (::signalfd(signal_fd_, &mask, SFD_NONBLOCK | SFD_CLOEXEC) < 0) {
+      ec = std::error_code(errno, std::generic_category());
+      if (!sigismember(&old_mask, signal_number)) {
+        ::pthread_sigmask(SIG_UNBLOCK, &block, 0);
+      }
+      if (s.registration_count_[signal_number] == 0) {
+        ::sigaction(signal_number, &s.old_action_[signal_number], 0);
+      }
+      return false;
+    }
+    if (s.registration_count_[signal_number]++ == 0) {
+      s.unblock_[signal_number] = !sigismember(&old_mask, signal_number);
+      s.blocking_thread_[signal_number] = ::pthread_self();
+    }
+    mask_ = mask;
+    return true;
+  }
+
+  // һעƳʱָԭĴʽ ڵһע߳ϵԭûʱ
+  static void restore_signal(int signal_number)
+  {
+    state& s = get_state();
+    if (--s.registration_count_[signal_number] != 0) {
+      return;
+    }
+    ::sigaction(signal_number, &s.old_action_[signal_number], 0);
+    if (s.unblock_[signal_number] && ::pthread_equal(s.blocking_thread_[signal_number], ::pthread_self())) {
+      sigset_t block;
+      sigemptyset(&block);
+      sigaddset(&block, signal_number);
+      ::pthread_sigmask(SIG_UNBLOCK, &block, 0);
+    }
+  }
+
+  // źűժ һעƳʱsignalfdźżȥ
+  void unlink(registration* reg)
+  {
+    if (registrations_[reg->signal_number_] == reg) {
+      registrations_[reg->signal_number_] = reg->next_in_table_;
+    }
+    if (reg->prev_in_table_) {
+      reg->prev_in_table_->next_in_table_ = reg->next_in_table_;
+    }
+    if (reg->next_in_table_) {
+      reg->next_in_table_->prev_in_table_ = reg->prev_in_table_;
+    }
+    if (registrations_[reg->signal_number_] == 0) {
+      sigdelset(&mask_, reg->signal_number_);
+      ::signalfd(signal_fd_, &mask_, SFD_NONBLOCK | SFD_CLOEXEC);
+      restore_signal(reg->signal_number_);
+    }
+  }
+
+  io_context_impl& scheduler_;
+  epoll_reactor& reactor_;
+  int signal_fd_;
+  sigset_t mask_;
+  epoll_reactor::ptr_descriptor_data reactor_data_;
+  signal_read_op read_op_;
+  registration* registrations_[max_signal_number];
+  signal_set_service* next_;
+  signal_set_service* prev_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_SIGNAL_SET_SERVICE_HPP
@@ -0,0 +1,294 @@
+#ifndef BOOST_ASIO_DETAIL_SOCKET_OPS_HPP
+#define BOOST_ASIO_DETAIL_SOCKET_OPS_HPP
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <system_error>
+#include "buffer.hpp"
+#include "descriptor_ops.hpp"
+#include "error_code.hpp"
+
+// socketϵͳ÷װ ½socketǷ+CLOEXEC
+namespace boost::asio::detail::socket_ops {
+
+using descriptor_ops::last_error;
+using descriptor_ops::would_block;
+
+// sendmsg/recvmsgĲ ɵ߱/
+struct message
+{
+  void* addr_;           // Զ˵ַ Ϊ
+  socklen_t addr_len_;   // ַ recvmsgʱʵʳ
+  void* control_;        // ݻ Ϊ
+  std::size_t control_len_;
+  int flags_;            // recvmsgصmsg_flags
+};
+
+inline int socket(int af, int type, int protocol, std::error_code& ec)
+{
+  int s = ::socket(af, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+  ec = s < 0 ? last_error() : std::error_code();
+  return s;
+}
+
+inline bool socketpair(int af, int type, int protocol, int sv[2], std::error_code& ec)
+{
+  if (::socketpair(af, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol, sv) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline int close(int s, std::error_code& ec) { return descriptor_ops::close(s, ec); }
+
+inline bool bind(int s, const void* addr, socklen_t addr_len, std::error_code& ec)
+{
+  if (::bind(s, static_cast<const sockaddr*>(addr), addr_len) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool listen(int s, int backlog, std::error_code& ec)
+{
+  if (::listen(s, backlog) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool shutdown(int s, int how, std::error_code& ec)
+{
+  if (::shutdown(s, how) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool setsockopt(int s, int level, int name, const void* value, socklen_t len, std::error_code& ec)
+{
+  if (::setsockopt(s, level, name, value, len) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool getsockopt(int s, int level, int name, void* value, socklen_t* len, std::error_code& ec)
+{
+  if (::getsockopt(s, level, name, value, len) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool getsockname(int s, void* addr, socklen_t* addr_len, std::error_code& ec)
+{
+  if (::getsockname(s, static_cast<sockaddr*>(addr), addr_len) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+inline bool getpeername(int s, void* addr, socklen_t* addr_len, std::error_code& ec)
+{
+  if (::getpeername(s, static_cast<sockaddr*>(addr), addr_len) != 0) {
+    ec = last_error();
+    return false;
+  }
+  ec = std::error_code();
+  return true;
+}
+
+// accept falseʾҪȴɶ
+inline bool non_blocking_accept(int s, void* addr, socklen_t* addr_len, std::error_code& ec, int& new_socket)
+{
+  for (;;) {
+    new_socket = ::accept4(s, static_cast<sockaddr*>(addr), addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (new_socket >= 0) {
+      ec = std::error_code();
+      return true;
+    }
+    if (errno == EINTR || errno == ECONNABORTED) {
+      continue;
+    }
+    if (would_block(errno)) {
+      return false;
+    }
+    ec = last_error();
+    return true;
+  }
+}
+
+//  falseʾڽ
+inline bool start_connect(int s, const void* addr, socklen_t addr_len, std::error_code& ec)
+{
+  if (::connect(s, static_cast<const sockaddr*>(addr), addr_len) == 0) {
+    ec = std::error_code();
+    return true;
+  }
+  if (errno == EINPROGRESS) {
+    return false;
+  }
+  ec = last_error();
+  return true;
+}
+
+// ӽеsocketΪд ȡSO_ERRORõӽ
+inline bool non_blocking_connect(int s, std::error_code& ec)
+{
+  pollfd fds;
+  fds.fd = s;
+  fds.events = POLLOUT;
+  fds.revents = 0;
+  if (::poll(&fds, 1, 0) == 0) {
+    return false;
+  }
+  int connect_error = 0;
+  socklen_t len = sizeof(connect_error);
+  if (getsockopt(s, SOL_SOCKET, SO_ERROR, &connect_error, &len, ec)) {
+    ec = connect_error ? std::error_code(connect_error, std::generic_category()) : std::error_code();
+  }
+  return true;
+}
+
+inline msghdr make_msghdr(const void* data, std::size_t size, iovec& iov, message* m)
+{
+  iov.iov_base = const_cast<void*>(data);
+  iov.iov_len = size;
+  msghdr msg = msghdr();
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  if (m) {
+    msg.msg_name = m->addr_;
+    msg.msg_namelen = m->addr_ ? m->addr_len_ : 0;
+    msg.msg_control = m->control_len_ ? m->control_ : 0;
+    msg.msg_controllen = m->control_len_;
+  }
+  return msg;
+}
+
+// sendmsg falseʾҪȴд
+inline bool non_blocking_sendmsg(int s, const const_buffer& b, message* m, std::error_code& ec,
+                                 std::size_t& bytes_transferred)
+{
+  iovec iov;
+  msghdr msg = make_msghdr(b.data(), b.size(), iov, m);
+  for (;;) {
+    ssize_t n = ::sendmsg(s, &msg, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && would_block(errno)) {
+      return false;
+    }
+    if (n < 0) {
+      ec = last_error();
+      bytes_transferred = 0;
+    } else {
+      ec = std::error_code();
+      bytes_transferred = n;
+    }
+    return true;
+  }
+}
+
+// recvmsg ʽsocket0ֽΪeof յCLOEXEC
+inline bool non_blocking_recvmsg(int s, const mutable_buffer& b, bool is_stream, message* m, std::error_code& ec,
+                                 std::size_t& bytes_transferred)
+{
+  iovec iov;
+  msghdr msg = make_msghdr(b.data(), b.size(), iov, m);
+  for (;;) {
+    ssize_t n = ::recvmsg(s, &msg, MSG_CMSG_CLOEXEC);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && would_block(errno)) {
+      return false;
+    }
+    if (n < 0) {
+      ec = last_error();
+      bytes_transferred = 0;
+    } else {
+      ec = (n == 0 && is_stream && b.size() != 0) ? make_error_code(error_code::eof) : std::error_code();
+      bytes_transferred = n;
+      if (m) {
+        m->addr_len_ = msg.msg_namelen;
+        m->control_len_ = msg.msg_controllen;
+        m->flags_ = msg.msg_flags;
+      }
+    }
+    return true;
+  }
+}
+
+inline std::size_t sync_sendmsg(int s, const const_buffer& b, message* m, std::error_code& ec)
+{
+  if (s == -1) {
+    ec = std::error_code(EBADF, std::generic_category());
+    return 0;
+  }
+  std::size_t bytes_transferred = 0;
+  while (!non_blocking_sendmsg(s, b, m, ec, bytes_transferred)) {
+    if (descriptor_ops::poll(s, POLLOUT, ec) < 0 && ec) {
+      return 0;
+    }
+  }
+  return bytes_transferred;
+}
+
+inline std::size_t sync_recvmsg(int s, const mutable_buffer& b, bool is_stream, message* m, std::error_code& ec)
+{
+  if (s == -1) {
+    ec = std::error_code(EBADF, std::generic_category());
+    return 0;
+  }
+  std::size_t bytes_transferred = 0;
+  while (!non_blocking_recvmsg(s, b, is_stream, m, ec, bytes_transferred)) {
+    if (descriptor_ops::poll(s, POLLIN, ec) < 0 && ec) {
+      return 0;
+    }
+  }
+  return bytes_transferred;
+}
+
+inline int sync_accept(int s, void* addr, socklen_t* addr_len, std::error_code& ec)
+{
+  int new_socket = -1;
+  while (!non_blocking_accept(s, addr, addr_len, ec, new_socket)) {
+    if (descriptor_ops::poll(s, POLLIN, ec) < 0 && ec) {
+      return -1;
+    }
+  }
+  return new_socket;
+}
+
+inline void sync_connect(int s, const void* addr, socklen_t addr_len, std::error_code& ec)
+{
+  if (start_connect(s, addr, addr_len, ec)) {
+    return;
+  }
+  while (!non_blocking_connect(s, ec)) {
+    if (descriptor_ops::poll(s, POLLOUT, ec) < 0 && ec) {
+      return;
+    }
+  }
+}
+}  // namespace boost::asio::detail::socket_ops
+#endif  // !BOOST_ASIO_DETAIL_SOCKET_OPS_HPP
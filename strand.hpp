@@ -4,6 +4,10 @@
 #include "strand_executor_service.hpp"
 
 namespace boost::asio {
+namespace detail {
+template <typename>
+struct executor_operation_traits;
+}
 
 template <typename Executor>
 class strand
@@ -38,12 +42,12 @@ class strand
     return *this;
   }
 #if defined(BOOST_ASIO_HAS_MOVE)
-  strand(strand&& other)
+  strand(strand&& other) noexcept
       : executor_(std::forward<Executor>(other.executor_)), impl_(std::forward<impl_type>(other.impl_))
   {}
 
   template <class OtherExecutor>
-  strand(strand<OtherExecutor>&& other)
+  strand(strand<OtherExecutor>&& other) noexcept
       : executor_(std::forward<Executor>(other.executor_)), impl_(std::forward<impl_type>(other.impl_))
   {}
 
@@ -91,16 +95,37 @@ class strand
     detail::strand_executor_service::defer(impl_, executor_, std::forward<Function>(func), a);
   }
 
-  bool running_in_this_thrand() const { return detail::strand_executor_service::running_in_this_thread(impl_); }
+  // һִ߳еĴ
+  std::size_t migrations() const { return detail::strand_executor_service::migrations(impl_); }
+
+  bool running_in_this_thread() const { return detail::strand_executor_service::running_in_this_thread(impl_); }
 
   friend bool operator==(const strand& a, const strand& b) { return a.impl_ == b.impl_; }
 
   friend bool operator!=(const strand& a, const strand& b) { return a.impl_ != b.impl_; }
 
  private:
+  template <typename>
+  friend struct detail::executor_operation_traits;
+
   Executor executor_;
   using impl_type = detail::strand_executor_service::impl_type;
   impl_type impl_;
 };
+
+// io_contextstrandÿִеԤ max_handlers/max_timeΪ0ʾ
+inline void set_strand_budget(io_context& ioc, std::size_t max_handlers,
+                              std::chrono::nanoseconds max_time = std::chrono::nanoseconds::zero())
+{
+  use_service<detail::strand_executor_service>(ioc).set_budget(max_handlers, max_time);
+}
+
+// ׺ģʽ: strandϴִִ߳У̻߳ѹlimitʱŻ߳
+inline void set_strand_affinity(io_context& ioc, bool enable,
+                                std::size_t limit = detail::scheduler::default_affinity_limit)
+{
+  use_service<detail::io_context_impl>(ioc).set_affinity_limit(limit);
+  use_service<detail::strand_executor_service>(ioc).set_affinity(enable);
+}
 }  // namespace boost::asio
 #endif  // !BOOST_ASIO_STRAND_HPP
\ No newline at end of file
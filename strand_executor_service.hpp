@@ -1,97 +1,211 @@
 #ifndef BOOST_ASIO_DETAIL_STRAND_EXECUTOR_SERVICE_HPP
 #define BOOST_ASIO_DETAIL_STRAND_EXECUTOR_SERVICE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "call_stack.hpp"
 #include "execution_context.hpp"
 #include "executor_op.hpp"
 #include "executor_work_guard.hpp"
 #include "handler_invoke_helpers.hpp"
 #include "mutex.hpp"
 #include "op_queue.hpp"
+#include "recycling_allocator.hpp"
 #include "scheduler_operation.hpp"
+#include "service_registry_helpers.hpp"
+#include "strand_statistics.hpp"
 
 namespace boost::asio::detail {
 
 class strand_executor_service : public execution_context_service_base<strand_executor_service>
 {
  public:
-  class strand_impl
+  // ж slabڵstrandstate_ref_count_ڵĻ
+  class alignas(64) strand_impl
   {
    public:
-    ~strand_impl()
+    strand_impl()
+        : state_(0), ref_count_(0), last_thread_(scheduler::no_thread), migrations_(0), shard_(0), next_(0), prev_(0),
+          service_(0)
+    {}
+
+   private:
+    friend class strand_executor_service;
+
+    // ״̬: 2λΪ־λΪȴеջָ
+    // ȴʽMPSCջCASѹջinvokerһȡջתΪFIFO
+    enum
+    {
+      locked = 1,    // invokerȻִ
+      shutdown = 2,  // ѹرգ²ֱ
+      flag_mask = 3
+    };
+
+    std::atomic<std::uintptr_t> state_;
+    op_queue<scheduler_operation> ready_queue_;  // ֻгlockedһ
+    std::atomic<long> ref_count_;
+    std::atomic<std::size_t> last_thread_;  // ϴִеscheduleṟ߳
+    std::atomic<std::size_t> migrations_;   // һִ߳еĴ
+    std::size_t shard_;  // ڵעƬ
+    strand_impl* next_;  // עʱΪ
+    strand_impl* prev_;
+    strand_executor_service* service_;
+  };
+
+  // ʽüstrand_implָ ʱstrand_implصĶ
+  class impl_type
+  {
+   public:
+    impl_type() : impl_(0) {}
+    impl_type(const impl_type& other) : impl_(other.impl_)
     {
-      // Ƴthis
-      if (service_->impl_list_ == this) {
-        service_->impl_list_ = next_;
+      if (impl_) {
+        impl_->ref_count_.fetch_add(1, std::memory_order_relaxed);
       }
-      if (prev_) {
-        prev_->next_ = next_;
+    }
+    impl_type(impl_type&& other) noexcept : impl_(other.impl_) { other.impl_ = 0; }
+    ~impl_type() { reset(); }
+
+    impl_type& operator=(const impl_type& other)
+    {
+      impl_type tmp(other);
+      std::swap(impl_, tmp.impl_);
+      return *this;
+    }
+
+    impl_type& operator=(impl_type&& other)
+    {
+      if (this != &other) {
+        reset();
+        impl_ = other.impl_;
+        other.impl_ = 0;
       }
-      if (next_) {
-        next_->prev_ = prev_;
+      return *this;
+    }
+
+    strand_impl* get() const { return impl_; }
+    strand_impl* operator->() const { return impl_; }
+    explicit operator bool() const { return impl_ != 0; }
+
+    void reset()
+    {
+      if (impl_) {
+        if (impl_->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          impl_->service_->release_impl(impl_);
+        }
+        impl_ = 0;
       }
     }
 
+    friend bool operator==(const impl_type& a, const impl_type& b) { return a.impl_ == b.impl_; }
+    friend bool operator!=(const impl_type& a, const impl_type& b) { return a.impl_ != b.impl_; }
+
    private:
     friend class strand_executor_service;
-    detail::mutex* mutex_;
-    bool locked_;  // жǷ񱻳
-    bool shutdown_;
-    op_queue<scheduler_operation> waiting_queue_;
-    op_queue<scheduler_operation> ready_queue_;
-    strand_impl* next_;
-    strand_impl* prev_;
-    strand_executor_service* service_;
+    explicit impl_type(strand_impl* impl) : impl_(impl) {}
+    strand_impl* impl_;
   };
 
-  using impl_type = std::shared_ptr<strand_impl>;
-
   explicit strand_executor_service(execution_context& ctx)
-      : execution_context_service_base<strand_executor_service>(ctx), mutex_(), salt_(0), impl_list_(0)
+      : execution_context_service_base<strand_executor_service>(ctx),
+        free_list_(0),
+        affinity_(false),
+        max_handlers_(0),
+        max_time_(0),
+        invocations_(0),
+        handlers_(0),
+        handler_budget_hits_(0),
+        time_budget_hits_(0),
+        migrations_(0)
   {}
 
+  // ÿinvokerִеԤ 0ʾ
+  // дʱinvokerpostĩβstrandִ
+  void set_budget(std::size_t max_handlers, std::chrono::nanoseconds max_time)
+  {
+    max_handlers_.store(max_handlers, std::memory_order_relaxed);
+    max_time_.store(max_time.count(), std::memory_order_relaxed);
+  }
+
+  void statistics(strand_statistics& out) const
+  {
+    out.invocations = invocations_.load(std::memory_order_relaxed);
+    out.handlers = handlers_.load(std::memory_order_relaxed);
+    out.handler_budget_hits = handler_budget_hits_.load(std::memory_order_relaxed);
+    out.time_budget_hits = time_budget_hits_.load(std::memory_order_relaxed);
+    out.migrations = migrations_.load(std::memory_order_relaxed);
+  }
+
+  void reset_statistics()
+  {
+    invocations_.store(0, std::memory_order_relaxed);
+    handlers_.store(0, std::memory_order_relaxed);
+    handler_budget_hits_.store(0, std::memory_order_relaxed);
+    time_budget_hits_.store(0, std::memory_order_relaxed);
+    migrations_.store(0, std::memory_order_relaxed);
+  }
+
+  // ׺ģʽ: io_contextϵstrandȻصϴִ߳
+  // ̵߳׺ͶʱŽ빫Уִ߳
+  void set_affinity(bool enable) { affinity_.store(enable, std::memory_order_relaxed); }
+  bool affinity() const { return affinity_.load(std::memory_order_relaxed); }
+
+  static std::size_t migrations(const impl_type& impl) { return impl->migrations_.load(std::memory_order_relaxed); }
+
   void shutdown()
   {
     op_queue<scheduler_operation> ops;
-    mutex::scoped_lock lock(mutex_);
-    while (strand_impl* impl = impl_list_) {
-      impl->mutex_->lock();
-      impl->shutdown_ = true;
-      ops.push(impl->waiting_queue_);
-      ops.push(impl->ready_queue_);
-      impl->mutex_->unlock();
-      impl = impl->next_;
+    for (std::size_t i = 0; i < num_shards; ++i) {
+      mutex::scoped_lock lock(shards_[i].mutex_);
+      for (strand_impl* impl = shards_[i].impl_list_; impl != 0; impl = impl->next_) {
+        std::uintptr_t state = impl->state_.fetch_or(strand_impl::shutdown, std::memory_order_acq_rel);
+        if (!(state & strand_impl::locked)) {
+          ops.push(impl->ready_queue_);
+        }
+        take_waiting(impl, ops);
+      }
     }
   }
 
+  // strand_implȴӱ̵߳Ļȡٴӿȡûʱһslab
+  // ֻӱ̶߳ӦעƬ
   impl_type create_impl()
   {
-    impl_type new_impl(new strand_impl);
-    new_impl->locked_ = false;
-    new_impl->shutdown_ = false;
-    mutex::scoped_lock lock(mutex_);
-
-    // TEA 㷨
-    std::size_t salt = salt_++;
-    std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
-    mutex_index += (reinterpret_cast<std::size_t>(new_impl.get()) >> 3);
-    mutex_index ^= salt + 0x9e3779b9 + (mutex_index << 6) + (mutex_index >> 2);
-    mutex_index = mutex_index % num_mutexes;
-    if (!mutexes_[mutex_index].get()) {
-      mutexes_[mutex_index].reset(new mutex);
+    strand_impl* new_impl = 0;
+    if (!cache_pop(new_impl)) {
+      new_impl = pool_pop();
     }
-    new_impl->mutex_ = mutexes_[mutex_index].get();
+    new_impl->ref_count_.store(1, std::memory_order_relaxed);
+    new_impl->state_.store(0, std::memory_order_relaxed);
+    new_impl->last_thread_.store(scheduler::no_thread, std::memory_order_relaxed);
+    new_impl->migrations_.store(0, std::memory_order_relaxed);
+    new_impl->service_ = this;
+    new_impl->shard_ = this_thread_index() % num_shards;
 
     // this
-    new_impl->next_ = impl_list_;
+    registry_shard& shard = shards_[new_impl->shard_];
+    mutex::scoped_lock lock(shard.mutex_);
+    new_impl->next_ = shard.impl_list_;
     new_impl->prev_ = 0;
-    if (impl_list_) {
-      impl_list_->prev_ = new_impl.get();
+    if (shard.impl_list_) {
+      shard.impl_list_->prev_ = new_impl;
     }
-    impl_list_ = new_impl.get();
-    new_impl->service_ = this;
+    shard.impl_list_ = new_impl;
+
+    return impl_type(new_impl);
+  }
 
-    return new_impl;
+  // еstrand_impl
+  std::size_t pool_capacity() const
+  {
+    mutex::scoped_lock lock(pool_mutex_);
+    return slabs_.size() * impls_per_slab;
   }
 
   template <typename Executor, typename Function, typename Alloc>
@@ -111,7 +225,10 @@ class strand_executor_service : public execution_context_service_base<strand_exe
     bool first = enqueue(impl, p.p);
     p.v = p.p = 0;
     if (first) {
-      ex.dispatch(invoker<Executor>(impl, ex), a);
+      invoker<Executor> i(impl, ex);
+      if (!post_affine(impl.get(), ex, i, a, true)) {
+        ex.dispatch(std::move(i), a);
+      }
     }
   }
 
@@ -123,11 +240,9 @@ class strand_executor_service : public execution_context_service_base<strand_exe
     typename op::ptr p = {std::addressof(a), op::ptr::allocate(a), 0};
     p.p = new (p.v) op(std::forward<Function>(func), a);
 
-    bool first = enqueue(impl, p.p);
+    scheduler_operation* o = p.p;
     p.v = p.p = 0;
-    if (first) {
-      ex.post(invoker<Executor>(impl, ex), a);
-    }
+    post_operation(impl, ex, o, a, false);
   }
 
   template <typename Executor, typename Function, typename Alloc>
@@ -138,10 +253,25 @@ class strand_executor_service : public execution_context_service_base<strand_exe
     typename op::ptr p = {std::addressof(a), op::ptr::allocate(a), 0};
     p.p = new (p.v) op(std::forward<Function>(func), a);
 
-    bool first = enqueue(impl, p.p);
+    scheduler_operation* o = p.p;
     p.v = p.p = 0;
-    if (first) {
-      ex.defer(invoker<Executor>(impl, ex), a);
+    post_operation(impl, ex, o, a, true);
+  }
+
+  // ͶѹõĲ any_executorٰװһ
+  template <typename Executor, typename Alloc>
+  static void post_operation(const impl_type& impl, Executor& ex, scheduler_operation* op, const Alloc& a,
+                             bool is_continuation)
+  {
+    if (enqueue(impl, op)) {
+      invoker<Executor> i(impl, ex);
+      if (!post_affine(impl.get(), ex, i, a, false)) {
+        if (is_continuation) {
+          ex.defer(std::move(i), a);
+        } else {
+          ex.post(std::move(i), a);
+        }
+      }
     }
   }
 
@@ -154,41 +284,70 @@ class strand_executor_service : public execution_context_service_base<strand_exe
   {
    public:
     invoker(const impl_type& impl, Executor& ex) : impl_(impl), work_(ex) {}
-    invoker(const invoker& other) : impl_(other.impl), work_(other.work_) {}
+    invoker(const invoker& other) : impl_(other.impl_), work_(other.work_) {}
 #if defined(BOOST_ASIO_HAS_MOVE)
-    invoker(invoker&& other)
-        : impl_(std::forward<impl_type>(other.impl_)), work_(std::forward<executor_work_guard<Executor>>(other.impl_))
-    {}
+    invoker(invoker&& other) : impl_(std::move(other.impl_)), work_(std::move(other.work_)) {}
 #endif
+    // Ԥóʱ빫 Ż׺Ͷлڱ߳ǰ棬ûó
     struct on_invoker_exit
     {
       invoker* this_;
+      bool yielded_;
       ~on_invoker_exit()
       {
-        this_->impl_->mutex_->lock();
-        this_->impl_->ready_queue_.push(this_->impl_->waiting_queue_);
-        bool more_handlers = this_->impl_->locked_ = !this_->impl_->ready_queue_.empty();
-        this_->impl_->mutex_->unlock();
-
-        if (more_handlers) {
+        if (!release(this_->impl_.get())) {
           Executor ex(this_->work_.get_executor());
           recycling_allocator<void> alloc;
-          ex.post(std::move(*this_), alloc);
+          if (yielded_ || !post_affine(this_->impl_.get(), ex, *this_, alloc, false)) {
+            ex.post(std::move(*this_), alloc);
+          }
         }
       }
     };
 
     void operator()()
     {
-      call_stack<strand_impl>::contains ctx(impl_.get());
-      on_invoker_exit on_exit = {this};
-      (void)on_exit;
-      
+      call_stack<strand_impl>::context ctx(impl_.get());
+      on_invoker_exit on_exit = {this, false};
+
+      strand_executor_service* service = impl_->service_;
+      if constexpr (std::is_same<Executor, io_context::executor_type>::value) {
+        std::size_t slot = use_service<io_context_impl>(work_.get_executor().context()).this_thread_slot();
+        std::size_t last = impl_->last_thread_.exchange(slot, std::memory_order_relaxed);
+        if (last != scheduler::no_thread && slot != scheduler::no_thread && slot != last) {
+          impl_->migrations_.fetch_add(1, std::memory_order_relaxed);
+          service->migrations_.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      std::size_t max_handlers = service->max_handlers_.load(std::memory_order_relaxed);
+      std::chrono::nanoseconds max_time(service->max_time_.load(std::memory_order_relaxed));
+      std::chrono::steady_clock::time_point start;
+      if (max_time.count()) {
+        start = std::chrono::steady_clock::now();
+      }
+
       std::error_code ec;
+      std::size_t n = 0;
       while (scheduler_operation* o = impl_->ready_queue_.front()) {
         impl_->ready_queue_.pop();
         o->complete(impl_.get(), ec, 0);
+        ++n;
+        if (impl_->ready_queue_.empty()) {
+          break;
+        }
+        if (max_handlers && n >= max_handlers) {
+          service->handler_budget_hits_.fetch_add(1, std::memory_order_relaxed);
+          on_exit.yielded_ = true;
+          break;
+        }
+        if (max_time.count() && std::chrono::steady_clock::now() - start >= max_time) {
+          service->time_budget_hits_.fetch_add(1, std::memory_order_relaxed);
+          on_exit.yielded_ = true;
+          break;
+        }
       }
+      service->invocations_.fetch_add(1, std::memory_order_relaxed);
+      service->handlers_.fetch_add(n, std::memory_order_relaxed);
     }
 
    private:
@@ -196,32 +355,211 @@ class strand_executor_service : public execution_context_service_base<strand_exe
     executor_work_guard<Executor> work_;
   };
 
+  // ׺ģʽ°invokerͶݵϴִе߳ ʱfalseɵԭ·
+  // dispatchϴִе߳ʱֱִ
+  template <typename Executor, typename Alloc>
+  static bool post_affine(strand_impl* impl, Executor& ex, invoker<Executor>& i, const Alloc& a, bool is_dispatch)
+  {
+    if constexpr (std::is_same<Executor, io_context::executor_type>::value) {
+      std::size_t slot = impl->last_thread_.load(std::memory_order_relaxed);
+      if (!impl->service_->affinity() || slot == scheduler::no_thread) {
+        return false;
+      }
+      scheduler& sched = use_service<io_context_impl>(ex.context());
+      if (is_dispatch && sched.this_thread_slot() == slot) {
+        return false;
+      }
+      using op = executor_op<invoker<Executor>, Alloc>;
+      typename op::ptr p = {std::addressof(a), op::ptr::allocate(a), 0};
+      p.p = new (p.v) op(std::move(i), a);
+      sched.post_affine(p.p, slot);
+      p.v = p.p = 0;
+      return true;
+    } else {
+      (void)impl, (void)ex, (void)i, (void)a, (void)is_dispatch;
+      return false;
+    }
+  }
+
+  // ޾ʱֻһCAS: lockedɵߵinvokerѹȴջ
   static bool enqueue(const impl_type& impl, scheduler_operation* op)
   {
-    impl->mutex_->lock();
-    if (impl->shutdown_) {
-      impl->mutex_->unlock();
-      op->destroy();
+    std::uintptr_t state = impl->state_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (state & strand_impl::shutdown) {
+        op->destroy();
+        return false;
+      }
+      if (!(state & strand_impl::locked)) {
+        if (impl->state_.compare_exchange_weak(state, strand_impl::locked, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+          impl->ready_queue_.push(op);
+          return true;
+        }
+        continue;
+      }
+      op_queue_access::next(op, reinterpret_cast<scheduler_operation*>(state & ~std::uintptr_t(strand_impl::flag_mask)));
+      if (impl->state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(op) | strand_impl::locked,
+                                             std::memory_order_release, std::memory_order_relaxed)) {
+        return false;
+      }
+    }
+  }
+
+  // ȡߵȴջջ˳׷ӵops
+  static void take_waiting(strand_impl* impl, op_queue<scheduler_operation>& ops)
+  {
+    std::uintptr_t state = impl->state_.fetch_and(strand_impl::flag_mask, std::memory_order_acquire);
+    scheduler_operation* head = reinterpret_cast<scheduler_operation*>(state & ~std::uintptr_t(strand_impl::flag_mask));
+    scheduler_operation* reversed = 0;
+    while (head) {
+      scheduler_operation* next = op_queue_access::next(head);
+      op_queue_access::next(head, reversed);
+      reversed = head;
+      head = next;
+    }
+    while (reversed) {
+      scheduler_operation* next = op_queue_access::next(reversed);
+      ops.push(reversed);
+      reversed = next;
+    }
+  }
+
+  // invoker˳ʱ: ûʣlockedtrueѵȴջready_queue_false
+  static bool release(strand_impl* impl)
+  {
+    if (impl->ready_queue_.empty()) {
+      std::uintptr_t state = strand_impl::locked;
+      if (impl->state_.compare_exchange_strong(state, 0, std::memory_order_release, std::memory_order_relaxed)) {
+        return true;
+      }
+      if (state & strand_impl::shutdown) {
+        return true;
+      }
+    }
+    take_waiting(impl, impl->ready_queue_);
+    return false;
+  }
+
+  enum
+  {
+    num_shards = 16,
+    impls_per_slab = 64,
+    num_caches = 37,
+    cache_depth = 16
+  };
+
+  // ü: עƳٹرպĲŻػ
+  void release_impl(strand_impl* impl)
+  {
+    {
+      registry_shard& shard = shards_[impl->shard_];
+      mutex::scoped_lock lock(shard.mutex_);
+      if (shard.impl_list_ == impl) {
+        shard.impl_list_ = impl->next_;
+      }
+      if (impl->prev_) {
+        impl->prev_->next_ = impl->next_;
+      }
+      if (impl->next_) {
+        impl->next_->prev_ = impl->prev_;
+      }
+    }
+    {
+      op_queue<scheduler_operation> ops;
+      ops.push(impl->ready_queue_);
+      take_waiting(impl, ops);
+    }
+    if (!cache_push(impl)) {
+      pool_push(impl);
+    }
+  }
+
+  static std::size_t this_thread_index() { return std::hash<std::thread::id>()(std::this_thread::get_id()); }
+
+  bool cache_pop(strand_impl*& impl)
+  {
+    cache_slot& c = caches_[this_thread_index() % num_caches];
+    if (c.busy_.test_and_set(std::memory_order_acquire)) {
       return false;
-    } else if (impl->locked_) {  // ѱУȴ...
-      impl->waiting_queue_.push(op);
-      impl->mutex_->unlock();
+    }
+    bool found = c.count_ != 0;
+    if (found) {
+      impl = c.items_[--c.count_];
+    }
+    c.busy_.clear(std::memory_order_release);
+    return found;
+  }
+
+  bool cache_push(strand_impl* impl)
+  {
+    cache_slot& c = caches_[this_thread_index() % num_caches];
+    if (c.busy_.test_and_set(std::memory_order_acquire)) {
       return false;
-    } else {
-      impl->locked_ = true;
-      impl->mutex_->unlock();
-      impl->ready_queue_.push(op);
-      return true;
     }
+    bool stored = c.count_ != cache_depth;
+    if (stored) {
+      c.items_[c.count_++] = impl;
+    }
+    c.busy_.clear(std::memory_order_release);
+    return stored;
   }
 
-  detail::mutex mutex_;
+  strand_impl* pool_pop()
+  {
+    mutex::scoped_lock lock(pool_mutex_);
+    if (!free_list_) {
+      slabs_.emplace_back(new strand_impl[impls_per_slab]);
+      strand_impl* slab = slabs_.back().get();
+      for (std::size_t i = 0; i < impls_per_slab; ++i) {
+        slab[i].next_ = free_list_;
+        free_list_ = &slab[i];
+      }
+    }
+    strand_impl* impl = free_list_;
+    free_list_ = impl->next_;
+    return impl;
+  }
+
+  void pool_push(strand_impl* impl)
+  {
+    mutex::scoped_lock lock(pool_mutex_);
+    impl->next_ = free_list_;
+    free_list_ = impl;
+  }
+
+  // עƬ shutdownʱзƬ
+  struct alignas(64) registry_shard
+  {
+    registry_shard() : impl_list_(0) {}
+    detail::mutex mutex_;
+    strand_impl* impl_list_;
+  };
+
+  struct alignas(64) cache_slot
+  {
+    cache_slot() : count_(0) { busy_.clear(); }
+    std::atomic_flag busy_;
+    std::size_t count_;
+    strand_impl* items_[cache_depth];
+  };
+
+  registry_shard shards_[num_shards];
+  cache_slot caches_[num_caches];
+
+  mutable detail::mutex pool_mutex_;  // slabs_free_list_
+  std::vector<std::unique_ptr<strand_impl[]>> slabs_;
+  strand_impl* free_list_;
 
-  static constexpr int num_mutexes = 193;
-  std::shared_ptr<mutex> mutexes_[num_mutexes];
+  std::atomic<bool> affinity_;
 
-  std::size_t salt_;
-  strand_impl* impl_list_;
+  std::atomic<std::size_t> max_handlers_;
+  std::atomic<std::chrono::nanoseconds::rep> max_time_;
+  std::atomic<std::size_t> invocations_;
+  std::atomic<std::size_t> handlers_;
+  std::atomic<std::size_t> handler_budget_hits_;
+  std::atomic<std::size_t> time_budget_hits_;
+  std::atomic<std::size_t> migrations_;
 };
 }  // namespace boost::asio::detail
 #endif  // !BOOST_ASIO_DETAIL_STRAND_EXECUTOR_SERVICE_HPP
@@ -0,0 +1,20 @@
+#ifndef BOOST_ASIO_STRAND_STATISTICS_HPP
+#define BOOST_ASIO_STRAND_STATISTICS_HPP
+
+#include <cstddef>
+
+namespace boost::asio {
+
+// strandȵļ strand_executor_serviceۼ
+struct strand_statistics
+{
+  strand_statistics() : invocations(0), handlers(0), handler_budget_hits(0), time_budget_hits(0), migrations(0) {}
+
+  std::size_t invocations;          // invokerִд
+  std::size_t handlers;             // ִеĴ
+  std::size_t handler_budget_hits;  // ó̵߳Ĵ
+  std::size_t time_budget_hits;     // ִʱó̵߳Ĵ
+  std::size_t migrations;           // strandһִ߳еĴ
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_STRAND_STATISTICS_HPP
@@ -0,0 +1,174 @@
+#ifndef BOOST_ASIO_POSIX_STREAM_DESCRIPTOR_HPP
+#define BOOST_ASIO_POSIX_STREAM_DESCRIPTOR_HPP
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+#include "async_result.hpp"
+#include "basic_io_object.hpp"
+#include "reactive_descriptor_service.hpp"
+#include "throw_exception.hpp"
+
+namespace boost::asio::posix {
+
+class descriptor_base
+{
+ public:
+  enum wait_type
+  {
+    wait_read = detail::reactive_descriptor_service::wait_read,
+    wait_write = detail::reactive_descriptor_service::wait_write,
+    wait_error = detail::reactive_descriptor_service::wait_error
+  };
+
+ protected:
+  ~descriptor_base() {}
+};
+
+// POSIX ܵttyeventfd
+class stream_descriptor : public basic_io_object<detail::reactive_descriptor_service>, public descriptor_base
+{
+ public:
+  using native_handle_type = detail::reactive_descriptor_service::native_handle_type;
+
+  explicit stream_descriptor(io_context& ioc) : basic_io_object<detail::reactive_descriptor_service>(ioc) {}
+
+  stream_descriptor(io_context& ioc, const native_handle_type& descriptor)
+      : basic_io_object<detail::reactive_descriptor_service>(ioc)
+  {
+    std::error_code ec;
+    this->get_service().assign(this->get_impl(), descriptor, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  ~stream_descriptor() {}
+
+  void assign(const native_handle_type& descriptor)
+  {
+    std::error_code ec;
+    this->get_service().assign(this->get_impl(), descriptor, ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void assign(const native_handle_type& descriptor, std::error_code& ec)
+  {
+    this->get_service().assign(this->get_impl(), descriptor, ec);
+  }
+
+  bool is_open() const { return this->get_service().is_open(this->get_impl()); }
+
+  native_handle_type native_handle() const { return this->get_service().native_handle(this->get_impl()); }
+
+  void close()
+  {
+    std::error_code ec;
+    this->get_service().close(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  void close(std::error_code& ec) { this->get_service().close(this->get_impl(), ec); }
+
+  //  ߸ر
+  native_handle_type release() { return this->get_service().release(this->get_impl()); }
+
+  void cancel()
+  {
+    std::error_code ec;
+    this->get_service().cancel(this->get_impl(), ec);
+    if (ec) detail::throw_exception(ec);
+  }
+
+  std::size_t read_some(const mutable_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().read_some(this->get_impl(), buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t read_some(const mutable_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().read_some(this->get_impl(), buffer, ec);
+  }
+
+  std::size_t write_some(const const_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = this->get_service().write_some(this->get_impl(), buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t write_some(const const_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().write_some(this->get_impl(), buffer, ec);
+  }
+
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type
+  async_read_some(const mutable_buffer& buffer, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_read_some(this->get_impl(), buffer, init.handler_);
+    return init.result_.get();
+  }
+
+  // ݵʱŴio_contextĻȡ
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, pooled_buffer, std::size_t)>::result_type
+  async_read_some(ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, pooled_buffer, std::size_t)> init(handler);
+    this->get_service().async_read_some_pooled(this->get_impl(), init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type
+  async_write_some(const const_buffer& buffer, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_write_some(this->get_impl(), buffer, init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename WaitHandler>
+  typename detail::async_result_helper<WaitHandler, void(std::error_code)>::result_type async_wait(
+      wait_type w, WaitHandler&& handler)
+  {
+    async_completion<WaitHandler, void(std::error_code)> init(handler);
+    this->get_service().async_wait(this->get_impl(), static_cast<detail::reactive_descriptor_service::wait_type>(w),
+                                   init.handler_);
+    return init.result_.get();
+  }
+};
+
+// ֱܵ𽻸˺д
+inline void connect_pipe(stream_descriptor& read_end, stream_descriptor& write_end, std::error_code& ec)
+{
+  int fds[2];
+  if (::pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0) {
+    ec = std::error_code(errno, std::generic_category());
+    return;
+  }
+  read_end.assign(fds[0], ec);
+  if (ec) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return;
+  }
+  write_end.assign(fds[1], ec);
+  if (ec) {
+    read_end.close();
+    ::close(fds[1]);
+  }
+}
+
+inline void connect_pipe(stream_descriptor& read_end, stream_descriptor& write_end)
+{
+  std::error_code ec;
+  connect_pipe(read_end, write_end, ec);
+  if (ec) detail::throw_exception(ec);
+}
+}  // namespace boost::asio::posix
+#endif  // !BOOST_ASIO_POSIX_STREAM_DESCRIPTOR_HPP
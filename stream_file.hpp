@@ -0,0 +1,80 @@
+#ifndef BOOST_ASIO_STREAM_FILE_HPP
+#define BOOST_ASIO_STREAM_FILE_HPP
+
+#include "async_result.hpp"
+#include "basic_file.hpp"
+
+namespace boost::asio {
+
+// ˳дļ ʹļǰλãͬһʱֻӦһд
+// ʱPOSIX_FADV_SEQUENTIALں˼ӴԤ
+class stream_file : public basic_file
+{
+ public:
+  explicit stream_file(io_context& ioc) : basic_file(ioc) {}
+
+  stream_file(io_context& ioc, const std::string& path, flags open_flags) : basic_file(ioc) { open(path, open_flags); }
+
+  void open(const std::string& path, flags open_flags)
+  {
+    basic_file::open(path, open_flags);
+    std::error_code ignored;
+    this->get_service().advise(this->get_impl(), advise_sequential, 0, 0, ignored);
+  }
+
+  std::uint64_t seek(std::int64_t offset, seek_basis whence)
+  {
+    std::error_code ec;
+    std::uint64_t n = this->get_service().seek(this->get_impl(), offset, whence, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t read_some(const mutable_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = read_some(buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t read_some(const mutable_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().read_some_at(this->get_impl(), detail::file_op::current_position, buffer, ec);
+  }
+
+  std::size_t write_some(const const_buffer& buffer)
+  {
+    std::error_code ec;
+    std::size_t n = write_some(buffer, ec);
+    if (ec) detail::throw_exception(ec);
+    return n;
+  }
+
+  std::size_t write_some(const const_buffer& buffer, std::error_code& ec)
+  {
+    return this->get_service().write_some_at(this->get_impl(), detail::file_op::current_position, buffer, ec);
+  }
+
+  template <typename ReadHandler>
+  typename detail::async_result_helper<ReadHandler, void(std::error_code, std::size_t)>::result_type
+  async_read_some(const mutable_buffer& buffer, ReadHandler&& handler)
+  {
+    async_completion<ReadHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_read_some_at(this->get_impl(), detail::file_op::current_position, buffer,
+                                           init.handler_);
+    return init.result_.get();
+  }
+
+  template <typename WriteHandler>
+  typename detail::async_result_helper<WriteHandler, void(std::error_code, std::size_t)>::result_type
+  async_write_some(const const_buffer& buffer, WriteHandler&& handler)
+  {
+    async_completion<WriteHandler, void(std::error_code, std::size_t)> init(handler);
+    this->get_service().async_write_some_at(this->get_impl(), detail::file_op::current_position, buffer,
+                                            init.handler_);
+    return init.result_.get();
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_STREAM_FILE_HPP
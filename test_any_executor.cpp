@@ -0,0 +1,145 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include "any_executor.hpp"
+#include "strand.hpp"
+
+namespace test_any_executor {
+
+using namespace boost::asio;
+using strand_type = strand<io_context::executor_type>;
+
+static_assert(any_executor::stores_inline<io_context::executor_type>);
+static_assert(any_executor::stores_inline<strand_type>);
+
+std::size_t allocations = 0;
+
+// ͳƲķ
+template <typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&)
+  {}
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+};
+
+// ָСִ 浽ϣͨ·Ͷ
+struct padded_executor
+{
+  io_context::executor_type ex_;
+  void* padding_[2];
+
+  io_context& context() const { return ex_.context(); }
+  void on_work_started() const { ex_.on_work_started(); }
+  void on_work_finished() const { ex_.on_work_finished(); }
+
+  template <typename Function, typename Alloc>
+  void dispatch(Function&& f, const Alloc& a) const
+  {
+    ex_.dispatch(std::forward<Function>(f), a);
+  }
+  template <typename Function, typename Alloc>
+  void post(Function&& f, const Alloc& a) const
+  {
+    ex_.post(std::forward<Function>(f), a);
+  }
+  template <typename Function, typename Alloc>
+  void defer(Function&& f, const Alloc& a) const
+  {
+    ex_.defer(std::forward<Function>(f), a);
+  }
+
+  friend bool operator==(const padded_executor& a, const padded_executor& b) { return a.ex_ == b.ex_; }
+};
+
+int main()
+{
+  io_context ioc;
+  int count = 0;
+
+  // any_executorͶݺֱͶݵķͬ
+  any_executor ex = ioc.get_executor();
+  assert(ex.target<io_context::executor_type>() != 0);
+  assert(ex.target<strand_type>() == 0);
+  for (int i = 0; i < 100; ++i) {
+    ex.post([&] { ++count; }, counting_allocator<void>());
+  }
+  std::size_t wrapped = allocations;
+  allocations = 0;
+  for (int i = 0; i < 100; ++i) {
+    ioc.get_executor().post([&] { ++count; }, counting_allocator<void>());
+  }
+  assert(wrapped == allocations);
+  ioc.run();
+  assert(count == 200);
+
+  // io_context߳dispatchֱִ 
+  ioc.restart();
+  allocations = 0;
+  bool inline_call = false;
+  ex.post(
+      [&] {
+        std::size_t before = allocations;
+        ex.dispatch([&] { inline_call = true; }, counting_allocator<void>());
+        assert(allocations == before);
+      },
+      counting_allocator<void>());
+  ioc.run();
+  assert(inline_call);
+
+  // strandڶ ÿͶֻ䴦Ĳ
+  ioc.restart();
+  strand_type s(ioc.get_executor());
+  any_executor sx = s;
+  assert(sx.target<strand_type>() && *sx.target<strand_type>() == s);
+  const char* target = reinterpret_cast<const char*>(sx.target<strand_type>());
+  assert(target >= reinterpret_cast<const char*>(&sx) && target < reinterpret_cast<const char*>(&sx + 1));
+  allocations = 0;
+  count = 0;
+  for (int i = 0; i < 100; ++i) {
+    sx.post([&] { ++count; }, counting_allocator<void>());
+  }
+  assert(allocations == 100);
+  ioc.run();
+  assert(count == 100);
+
+  // ƶȽ
+  any_executor copy(sx);
+  assert(copy == sx && copy != ex);
+  any_executor moved(std::move(copy));
+  assert(!copy && moved == sx);
+  moved = nullptr;
+  assert(!moved);
+  bool thrown = false;
+  try {
+    moved.post([] {}, counting_allocator<void>());
+  } catch (const bad_executor&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  // ִ
+  ioc.restart();
+  count = 0;
+  any_executor px = padded_executor{ioc.get_executor(), {0, 0}};
+  any_executor px2 = px;
+  assert(px == px2);
+  px.post([&] { ++count; }, counting_allocator<void>());
+  px2.defer([&] { ++count; }, counting_allocator<void>());
+  ioc.run();
+  assert(count == 2);
+
+  std::cout << "sizeof(any_executor) = " << sizeof(any_executor) << '\n';
+  return 0;
+}
+}  // namespace test_any_executor
@@ -0,0 +1,88 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "arena_allocator.hpp"
+#include "associated_allocator.hpp"
+#include "io_context.hpp"
+#include "service_registry_helpers.hpp"
+
+namespace test_arena_allocator {
+
+using namespace boost::asio;
+
+std::atomic<int> remaining(0);
+
+struct chain
+{
+  arena_executor* ex_;
+  char payload_[40];
+
+  void operator()()
+  {
+    if (remaining.fetch_sub(1) > 1) {
+      ex_->post(chain{ex_, {}}, std::allocator<void>());
+    }
+  }
+};
+
+int main()
+{
+  io_context ioc;
+  detail::handler_arena& arena = use_service<detail::handler_arena>(ioc);
+
+  // ͷŵĿȽӳٻջ ͬһ߳ٷͬһʱȡ
+  {
+    arena_allocator<char> a(ioc);
+    char* p = a.allocate(100);
+    a.deallocate(p, 100);
+    char* q = a.allocate(128);
+    assert(q == p);
+    a.deallocate(q, 128);
+    assert(arena_allocator<char>(arena_allocator<int>(a)) == a);
+    assert(arena.capacity() == detail::handler_arena::slab_size);
+  }
+
+  // ڴط
+  {
+    int called = 0;
+    auto h = bind_arena(ioc, [&called] { ++called; });
+    arena_allocator<void> alloc = get_associated_allocator(h);
+    assert(alloc == arena_allocator<void>(ioc));
+    ioc.get_executor().post(h, alloc);
+    ioc.run();
+    assert(called == 1);
+    ioc.restart();
+  }
+
+  // ִĬϷ: ߳²ȫֶ
+  arena_executor ex(ioc.get_executor());
+  const int ops = 200000;
+  const int in_flight = 32;
+  remaining = ops;
+  std::size_t capacity = arena.capacity();
+  for (int i = 0; i < in_flight; ++i) {
+    ex.post(chain{&ex, {}}, std::allocator<void>());
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&ioc] { ioc.run(); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  assert(arena.heap_allocations() == 0);
+  assert(arena.capacity() <= capacity + 5 * detail::handler_arena::slab_size);
+
+  // رʱδִеĲڴ
+  ioc.restart();
+  for (int i = 0; i < 100; ++i) {
+    ex.post([] { assert(false); }, std::allocator<void>());
+  }
+
+  std::cout << "ops " << ops + in_flight << " arena capacity " << arena.capacity() << '\n';
+  return 0;
+}
+}  // namespace test_arena_allocator
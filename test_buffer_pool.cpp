@@ -0,0 +1,55 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "buffer_pool.hpp"
+#include "io_context.hpp"
+#include "service_registry_helpers.hpp"
+#include "thread_group.hpp"
+
+namespace test_buffer_pool {
+
+using namespace boost::asio;
+
+int main()
+{
+  io_context ioc;
+  auto& pool = make_service<detail::buffer_pool>(ioc, 4096, 8);
+
+  pooled_buffer b1 = pool.allocate();
+  std::memcpy(b1.data(), "hello", 6);
+  pooled_buffer b2 = b1;
+  assert(b1.use_count() == 2);
+  assert(b2.data() == b1.data());
+  b1.reset();
+  assert(b2.use_count() == 1);
+  std::cout << static_cast<const char*>(b2.data()) << " size = " << b2.size() << '\n';
+
+  void* p = b2.data();
+  b2.reset();
+  pooled_buffer b3 = pool.allocate();
+  assert(b3.data() == p);  // ߳ͷźӱ̵߳Ļȡͬһ
+
+  detail::thread_group threads;
+  threads.create_thread(
+      [&]() {
+        std::vector<pooled_buffer> v;
+        for (int i = 0; i < 10000; ++i) {
+          v.push_back(pool.allocate());
+          if (v.size() == 20) {
+            v.clear();
+          }
+        }
+      },
+      4);
+  threads.join();
+
+  // ÿ߳20 Ŀڻۻȫֿбظʹ
+  // slabֻڱ̻߳ȫΪʱ룬ÿϸеĿ
+  std::size_t bound = 1 + 4 * 20 + 5 * detail::buffer_pool::cache_depth + 8;
+  assert(pool.capacity() <= bound);
+
+  std::cout << "capacity = " << pool.capacity() << " slabs = " << pool.slab_count() << '\n';
+  return 0;
+}
+}  // namespace test_buffer_pool
@@ -0,0 +1,47 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "coarse_steady_timer.hpp"
+
+namespace test_coarse_steady_timer {
+
+using namespace boost::asio;
+
+using traits = detail::chrono_time_traits<std::chrono::steady_clock, wait_traits<std::chrono::steady_clock>>;
+
+int main()
+{
+  // ʱֻһ
+  {
+    detail::cached_clock_scope scope;
+    auto t1 = traits::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    assert(traits::now() == t1);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  assert(traits::now() > t1);
+
+  io_context ioc;
+  coarse_steady_timer timer(ioc, std::chrono::milliseconds(20));
+  coarse_steady_clock::time_point expiry = timer.expiry();
+  auto start = std::chrono::steady_clock::now();
+  bool fired = false;
+  timer.async_wait([&](const std::error_code& ec) {
+    assert(!ec);
+    // ʱʱѾ߹ʱ
+    assert(coarse_steady_clock::now() >= expiry);
+    fired = true;
+  });
+  ioc.run();
+  assert(fired);
+
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  assert(elapsed >= std::chrono::milliseconds(20) - coarse_steady_clock::resolution());
+
+  std::cout << "resolution " << coarse_steady_clock::resolution().count() << "ns, elapsed "
+            << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << "us\n";
+  return 0;
+}
+}  // namespace test_coarse_steady_timer
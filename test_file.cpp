@@ -0,0 +1,66 @@
+#include <unistd.h>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include "random_access_file.hpp"
+#include "read_until.hpp"
+#include "ring_streambuf.hpp"
+#include "stream_file.hpp"
+
+namespace test_file {
+
+using namespace boost::asio;
+
+int main()
+{
+  io_context ioc;
+  std::string path = "/tmp/test_file_" + std::to_string(::getpid());
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  std::cout << "io_uring " << (use_service<detail::io_uring_service>(ioc).enabled() ? "enabled" : "disabled") << '\n';
+#endif  // defined(BOOST_ASIO_HAS_IO_URING)
+
+  // ƫд ٶ
+  random_access_file f(ioc, path, file_base::read_write | file_base::create | file_base::truncate);
+  std::string head = "first line\n", tail = "second line\n";
+  f.async_write_some_at(0, buffer(head), [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == head.size());
+  });
+  f.async_write_some_at(head.size(), buffer(tail), [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == tail.size());
+  });
+  ioc.run();
+  assert(f.size() == head.size() + tail.size());
+
+  ioc.restart();
+  char data[64];
+  f.advise(file_base::advise_random);
+  char end_data[8];
+  f.async_read_some_at(head.size(), buffer(data), [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == tail.size());
+    assert(std::string(data, n) == tail);
+    std::cout << "read at " << head.size() << ": " << std::string(data, n);
+  });
+  f.async_read_some_at(f.size(), buffer(end_data), [&](const std::error_code& ec, std::size_t n) {
+    assert(ec == detail::error_code::eof && n == 0);
+    std::cout << "read at end: " << ec.message() << '\n';
+  });
+  ioc.run();
+  f.close();
+
+  // ˳ async_read_until
+  ioc.restart();
+  stream_file s(ioc, path, file_base::read_only);
+  s.readahead(0, 4096);
+  ring_streambuf sb(4096);
+  async_read_until(s, sb, '\n', [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == head.size());
+    assert(std::string(static_cast<const char*>(sb.data().data()), n) == head);
+    std::cout << "read_until: " << std::string(static_cast<const char*>(sb.data().data()), n);
+  });
+  ioc.run();
+
+  ::unlink(path.c_str());
+  return 0;
+}
+}  // namespace test_file
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "file_watcher.hpp"
+
+namespace test_file_watcher {
+
+using namespace boost::asio;
+
+const char* names[] = {"created", "modified", "moved", "deleted", "overflow"};
+
+void print(const std::vector<file_event>& events)
+{
+  for (const file_event& e : events) {
+    std::cout << names[e.type_] << ' ' << e.name_;
+    if (e.type_ == file_event::moved) {
+      std::cout << " <- " << e.old_name_;
+    }
+    std::cout << '\n';
+  }
+}
+
+int main()
+{
+  char dir[] = "/tmp/test_file_watcher.XXXXXX";
+  assert(::mkdtemp(dir));
+  std::string a = std::string(dir) + "/a.txt";
+  std::string b = std::string(dir) + "/b.txt";
+
+  io_context ioc;
+  file_watcher watcher(ioc);
+  watcher.add_watch(dir);
+  watcher.set_coalesce_window(std::chrono::milliseconds(50));
+
+  // ½д ֻһcreated
+  std::vector<file_event> events;
+  watcher.async_wait([&](const std::error_code& ec, std::vector<file_event> e) {
+    assert(!ec);
+    events = std::move(e);
+  });
+  std::ofstream(a) << "hello";
+  std::ofstream(a, std::ios::app) << " world";
+  ioc.run();
+  print(events);
+  assert(events.size() == 1 && events[0].type_ == file_event::created && events[0].name_ == "a.txt");
+
+  // ޸  ɾ
+  ioc.restart();
+  watcher.async_wait([&](const std::error_code& ec, std::vector<file_event> e) {
+    assert(!ec);
+    events = std::move(e);
+  });
+  std::ofstream(a, std::ios::app) << "!";
+  assert(std::rename(a.c_str(), b.c_str()) == 0);
+  assert(::unlink(b.c_str()) == 0);
+  ioc.run();
+  print(events);
+  assert(events.size() == 3);
+  assert(events[0].type_ == file_event::modified && events[0].name_ == "a.txt");
+  assert(events[1].type_ == file_event::moved && events[1].name_ == "b.txt" && events[1].old_name_ == "a.txt");
+  assert(events[2].type_ == file_event::deleted && events[2].name_ == "b.txt");
+
+  // ½ ɾ ½ ¼һļ״̬
+  ioc.restart();
+  watcher.async_wait([&](const std::error_code& ec, std::vector<file_event> e) {
+    assert(!ec);
+    events = std::move(e);
+  });
+  std::ofstream(a) << "first";
+  assert(::unlink(a.c_str()) == 0);
+  std::ofstream(a) << "second";
+  ioc.run();
+  print(events);
+  assert(events.size() == 3);
+  assert(events[0].type_ == file_event::created && events[0].name_ == "a.txt");
+  assert(events[1].type_ == file_event::deleted && events[1].name_ == "a.txt");
+  assert(events[2].type_ == file_event::created && events[2].name_ == "a.txt");
+
+  // cancelõȴoperation_aborted
+  ioc.restart();
+  watcher.async_wait([](const std::error_code& ec, std::vector<file_event>) {
+    std::cout << "cancel: " << ec.message() << '\n';
+  });
+  watcher.cancel();
+  ioc.run();
+
+  ::unlink(a.c_str());
+  ::rmdir(dir);
+  return 0;
+}
+}  // namespace test_file_watcher
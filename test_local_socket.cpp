@@ -0,0 +1,85 @@
+#include <unistd.h>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include "local_socket.hpp"
+
+namespace test_local_socket {
+
+using namespace boost::asio;
+
+std::string abstract_path(const char* name)
+{
+  return std::string(1, '\0') + name + std::to_string(::getpid());
+}
+
+int main()
+{
+  io_context ioc;
+
+  // 1. ݹܵд˺ƾ֤
+  local::stream_protocol::socket a(ioc), b(ioc);
+  local::connect_pair(a, b);
+  b.set_option(local::pass_credentials(true));
+
+  int pipefd[2];
+  assert(::pipe(pipefd) == 0);
+  local::ancillary out;
+  out.add_fd(pipefd[1]);
+  out.set_credentials();
+
+  local::ancillary in;
+  char data[16];
+  b.async_receive(buffer(data), in, [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == 1);
+    assert(in.fd_count() == 1 && in.has_credentials() && in.credentials().pid == ::getpid());
+    std::cout << "received fd " << in.fd(0) << " from pid " << in.credentials().pid << '\n';
+  });
+  a.async_send(buffer("x", 1), out, [&](const std::error_code& ec, std::size_t n) { assert(!ec && n == 1); });
+  ioc.run();
+  ::close(pipefd[1]);
+
+  assert(::write(in.fd(0), "via fd", 6) == 6);
+  in.close_fds();
+  char text[8] = {0};
+  assert(::read(pipefd[0], text, sizeof(text)) == 6);
+  ::close(pipefd[0]);
+  std::cout << "pipe: " << text << '\n';
+
+  // 2. socket: acceptoracceptorӹܺaccept
+  ioc.restart();
+  local::stream_protocol::endpoint ep(abstract_path("asio_handoff"));
+  local::stream_protocol::acceptor old_acceptor(ioc, ep);
+  local::ancillary handoff;
+  handoff.add_fd(old_acceptor.release());
+  a.send(buffer("h", 1), handoff);
+  ::close(handoff.fd(0));
+
+  local::ancillary got;
+  b.receive(buffer(data), got);
+  local::stream_protocol::acceptor new_acceptor(ioc);
+  new_acceptor.assign(local::stream_protocol(), got.fd(0));
+
+  local::stream_protocol::socket server(ioc), client(ioc);
+  new_acceptor.async_accept(server, [&](const std::error_code& ec) {
+    assert(!ec);
+    std::cout << "accepted on " << new_acceptor.local_endpoint().path().size() << "-byte abstract name\n";
+  });
+  client.async_connect(ep, [&](const std::error_code& ec) { assert(!ec); });
+  ioc.run();
+  assert(server.is_open());
+
+  // 3. ݱ send_to/receive_from
+  ioc.restart();
+  local::datagram_protocol::endpoint ep1(abstract_path("asio_dgram1")), ep2(abstract_path("asio_dgram2"));
+  local::datagram_protocol::socket d1(ioc, ep1), d2(ioc, ep2);
+  local::datagram_protocol::endpoint sender;
+  d2.async_receive_from(buffer(data), sender, [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && sender == ep1);
+    std::cout << "datagram " << std::string(data, n) << '\n';
+  });
+  d1.async_send_to(buffer("ping", 4), ep2, [&](const std::error_code& ec, std::size_t n) { assert(!ec && n == 4); });
+  ioc.run();
+  return 0;
+}
+}  // namespace test_local_socket
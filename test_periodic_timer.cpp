@@ -0,0 +1,161 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "executor_work_guard.hpp"
+#include "periodic_timer.hpp"
+
+namespace test_periodic_timer {
+
+using namespace boost::asio;
+using clock_type = std::chrono::steady_clock;
+
+std::size_t allocations = 0;
+
+// ͳhandlerķ
+template <typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&)
+  {}
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+};
+
+struct tick_handler
+{
+  using allocator_type = counting_allocator<void>;
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  void operator()(const std::error_code& ec, std::size_t ticks)
+  {
+    if (ec) {
+      assert(ec == detail::error_code::operation_aborted);
+      *aborted_ = true;
+      return;
+    }
+    times_->push_back(clock_type::now());
+    ticks_->push_back(ticks);
+    if (times_->size() == limit_) {
+      timer_->cancel();
+    }
+    std::this_thread::sleep_for(delay_);
+  }
+
+  periodic_timer* timer_;
+  std::vector<clock_type::time_point>* times_;
+  std::vector<std::size_t>* ticks_;
+  bool* aborted_;
+  std::size_t limit_;
+  std::chrono::milliseconds delay_;
+};
+
+void run(periodic_timer::missed_tick_policy policy, std::chrono::milliseconds delay, std::vector<std::size_t>& ticks)
+{
+  io_context ioc;
+  periodic_timer timer(ioc, std::chrono::milliseconds(10));
+  timer.set_missed_tick_policy(policy);
+
+  std::vector<clock_type::time_point> times;
+  bool aborted = false;
+  allocations = 0;
+
+  clock_type::time_point start = clock_type::now();
+  timer.async_start_at(start + timer.period(), tick_handler{&timer, &times, &ticks, &aborted, 10, delay});
+  assert(timer.running());
+  ioc.run();
+
+  // ֻasync_startʱһ
+  assert(allocations == 1);
+  assert(aborted);
+  assert(!timer.running());
+  assert(times.size() == 10);
+
+  // kλصstart + k * period
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    k += ticks[i];
+    assert(times[i] >= start + k * timer.period());
+  }
+}
+
+int main()
+{
+  // صڿ ÿticksΪ1
+  std::vector<std::size_t> ticks;
+  run(periodic_timer::skip, std::chrono::milliseconds(0), ticks);
+  for (std::size_t t : ticks) {
+    assert(t == 1);
+  }
+
+  // ص skipѴںϲһλص
+  ticks.clear();
+  run(periodic_timer::skip, std::chrono::milliseconds(35), ticks);
+  std::size_t skipped = 0;
+  for (std::size_t t : ticks) {
+    skipped += t;
+  }
+  assert(skipped > ticks.size());
+  std::size_t slow = ticks.size();
+
+  // catch_up
+  ticks.clear();
+  run(periodic_timer::catch_up, std::chrono::milliseconds(15), ticks);
+  for (std::size_t t : ticks) {
+    assert(t == 1);
+  }
+
+  // ߳ڻصʱcancel cancelǰᱻͷ
+  {
+    io_context ioc;
+    executor_work_guard<io_context::executor_type> work(ioc.get_executor());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+      threads.emplace_back([&ioc] { ioc.run(); });
+    }
+    periodic_timer timer(ioc, std::chrono::microseconds(50));
+    std::atomic<int> finished(0);
+    for (int i = 0; i < 200; ++i) {
+      timer.async_start([&finished](const std::error_code& ec, std::size_t) {
+        if (ec) {
+          ++finished;
+        }
+      });
+      std::this_thread::sleep_for(std::chrono::microseconds(i % 7 * 40));
+      timer.cancel();
+    }
+    work.reset();
+    for (auto& t : threads) {
+      t.join();
+    }
+    assert(finished == 200);
+  }
+
+  // ڱ0
+  io_context ioc;
+  periodic_timer timer(ioc);
+  bool thrown = false;
+  try {
+    timer.async_start([](const std::error_code&, std::size_t) {});
+  } catch (const std::error_code& ec) {
+    assert(ec == std::errc::invalid_argument);
+    thrown = true;
+  }
+  assert(thrown);
+
+  std::cout << "skip " << skipped << " periods in " << slow << " ticks\n";
+  return 0;
+}
+}  // namespace test_periodic_timer
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include "delimiter_search.hpp"
+#include "read_until.hpp"
+#include "ring_streambuf.hpp"
+
+namespace test_read_until {
+
+using namespace boost::asio;
+
+// ÿֻؼֽڵڴ ģⲿֶ
+struct chunked_stream
+{
+  std::string data_;
+  std::size_t pos_;
+  std::size_t chunk_;
+
+  template <typename Handler>
+  void async_read_some(const mutable_buffer& b, Handler&& handler)
+  {
+    std::size_t n = std::min({b.size(), chunk_, data_.size() - pos_});
+    std::memcpy(b.data(), data_.data() + pos_, n);
+    pos_ += n;
+    std::error_code ec;
+    if (n == 0 && b.size() != 0) {
+      ec = detail::error_code::eof;
+    }
+    handler(ec, n);
+  }
+};
+
+// offsetָ ȽSIMDͱʵ֣鲻Խλ
+void check_planted(std::string text, const std::string& delim, std::size_t offset)
+{
+  text.replace(offset, delim.size(), delim);
+  const char* last = text.data() + text.size();
+  for (std::size_t off = 0; off < 64 && off <= offset; ++off) {
+    const char* first = text.data() + off;
+    const char* found = detail::find_delimiter(first, last, delim.data(), delim.size());
+    assert(found == detail::find_delimiter_scalar(first, last, delim.data(), delim.size()));
+    assert(found <= text.data() + offset);
+  }
+}
+
+int main()
+{
+  // ʵֵĽͱʵһ
+  std::string text;
+  for (int i = 0; i < 4096; ++i) {
+    text += static_cast<char>('a' + (i * 7919) % 23);
+  }
+  const char* delims[] = {"\n", "w", "\r\n", "abc", "xyzw", "nopqrstuvwxyzabcdefghijklmnopqrs"};
+  for (const char* d : delims) {
+    for (std::size_t off = 0; off < 64; ++off) {
+      const char* first = text.data() + off;
+      const char* last = text.data() + text.size();
+      assert(detail::find_delimiter(first, last, d, std::strlen(d)) ==
+             detail::find_delimiter_scalar(first, last, d, std::strlen(d)));
+    }
+  }
+
+  // ָλ ԼԽ16/32ֽڿ߽λ
+  std::mt19937 rng(20261019);
+  for (const char* d : delims) {
+    std::string delim(d);
+    for (int i = 0; i < 200; ++i) {
+      check_planted(text, delim, rng() % (text.size() - delim.size() + 1));
+    }
+    for (std::size_t block = 32; block <= 256; block += 16) {
+      for (std::size_t j = 0; j < delim.size(); ++j) {
+        check_planted(text, delim, block - j);
+      }
+    }
+  }
+
+  // ɶλĩβ ָԽƵ
+  for (const char* d : delims) {
+    std::string delim(d);
+    for (std::size_t j = 0; j < delim.size(); ++j) {
+      ring_streambuf wrap(4096);
+      std::size_t start = wrap.capacity() - 100;
+      std::memcpy(wrap.prepare(start).data(), text.data(), start);
+      wrap.commit(start);
+      wrap.consume(start);
+      std::string line = text.substr(0, 200);
+      line.replace(100 - j, delim.size(), delim);
+      chunked_stream ws = {line, 0, 7};
+      std::size_t length = 0;
+      async_read_until(ws, wrap, delim, [&](const std::error_code& ec, std::size_t n) {
+        assert(!ec);
+        length = n;
+      });
+      const char* first = static_cast<const char*>(wrap.data().data());
+      const char* last = first + wrap.size();
+      const char* found = detail::find_delimiter(first, last, delim.data(), delim.size());
+      assert(found == detail::find_delimiter_scalar(first, last, delim.data(), delim.size()));
+      assert(length == static_cast<std::size_t>(found - first) + delim.size());
+      assert(length <= 100 - j + delim.size());
+    }
+  }
+
+  chunked_stream s = {"PING\r\nSET key value\r\n$5\r\nhello\r\n", 0, 3};
+  ring_streambuf b;
+  int lines = 0;
+  std::function<void(const std::error_code&, std::size_t)> on_line;
+  on_line = [&](const std::error_code& ec, std::size_t n) {
+    if (ec) {
+      std::cout << "read_until: " << ec.message() << '\n';
+      return;
+    }
+    std::cout << std::string(static_cast<const char*>(b.data().data()), n - 2) << '\n';
+    b.consume(n);
+    ++lines;
+    async_read_until(s, b, "\r\n", on_line);
+  };
+  async_read_until(s, b, "\r\n", on_line);
+  assert(lines == 4);
+  return 0;
+}
+}  // namespace test_read_until
@@ -0,0 +1,96 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "io_context.hpp"
+#include "recycling_allocator.hpp"
+
+namespace test_recycling_allocator {
+
+using namespace boost::asio;
+using detail::thread_cache;
+using detail::thread_info_base;
+
+std::atomic<int> remaining(0);
+
+// ˳ʱŶӲȫio_context ʱ̻ͨ߳ͷŲ
+io_context exit_ioc;
+
+// ÿͶһ ÿ߳ж;
+struct chain
+{
+  io_context* ioc_;
+  char payload_[40];
+
+  void operator()()
+  {
+    if (remaining.fetch_sub(1) > 1) {
+      ioc_->get_executor().post(chain{ioc_, {}}, detail::recycling_allocator<void>());
+    }
+  }
+};
+
+int main()
+{
+  // ߳ͷ: ص̵߳Զͷջ ߳´ηʱȡ
+  {
+    thread_info_base this_thread;
+    void* p = thread_info_base::allocate(&this_thread, 100);
+    std::thread([p] { thread_info_base::deallocate(0, p, 100); }).join();
+    std::size_t heap = thread_cache::heap_allocations();
+    void* q = thread_info_base::allocate(&this_thread, 100);
+    assert(q == p);
+    assert(thread_cache::heap_allocations() == heap);
+
+    // ͬһĴСÿп
+    thread_info_base::deallocate(&this_thread, q, 100);
+    q = thread_info_base::allocate(&this_thread, 120);
+    assert(q == p);
+    thread_info_base::deallocate(&this_thread, q, 120);
+  }
+
+  // Ϊ0ʱ
+  {
+    thread_info_base this_thread;
+    thread_cache::set_depth(0);
+    std::size_t heap = thread_cache::heap_allocations();
+    for (int i = 0; i < 10; ++i) {
+      thread_info_base::deallocate(&this_thread, thread_info_base::allocate(&this_thread, 64), 64);
+    }
+    assert(thread_cache::heap_allocations() == heap + 10);
+    thread_cache::set_depth(thread_cache::default_depth);
+  }
+
+  // ̶߳; malloc
+  io_context ioc;
+  const int ops = 200000;
+  const int in_flight = 32;
+  remaining = ops;
+  std::size_t heap = thread_cache::heap_allocations();
+  for (int i = 0; i < in_flight; ++i) {
+    ioc.get_executor().post(chain{&ioc, {}}, detail::recycling_allocator<void>());
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&ioc] { ioc.run(); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::size_t misses = thread_cache::heap_allocations() - heap;
+  assert(misses < ops / 100);
+
+  std::cout << "ops " << ops + in_flight << " heap allocations " << misses << '\n';
+
+  // Ͷһֹͣ µĲڽ˳ʱexit_iocͷ
+  exit_ioc.get_executor().post(
+      [] {
+        exit_ioc.get_executor().post([] { assert(false); }, detail::recycling_allocator<void>());
+        exit_ioc.stop();
+      },
+      detail::recycling_allocator<void>());
+  exit_ioc.run();
+  return 0;
+}
+}  // namespace test_recycling_allocator
@@ -0,0 +1,44 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "ring_streambuf.hpp"
+
+namespace test_ring_streambuf {
+
+using namespace boost::asio;
+
+void write(ring_streambuf& b, const std::string& s)
+{
+  mutable_buffer m = b.prepare(s.size());
+  std::memcpy(m.data(), s.data(), s.size());
+  b.commit(s.size());
+}
+
+int main()
+{
+  ring_streambuf b(4096);
+  std::size_t capacity = b.capacity();
+
+  // д/ѣԽĩβʱɶȻ
+  std::string frame(1000, 'x');
+  for (int i = 0; i < 100; ++i) {
+    frame[0] = static_cast<char>('a' + i % 26);
+    write(b, frame);
+    const_buffer d = b.data();
+    assert(d.size() == frame.size());
+    assert(std::memcmp(d.data(), frame.data(), frame.size()) == 0);
+    b.consume(frame.size());
+  }
+  assert(b.capacity() == capacity);
+
+  // ʱ
+  write(b, std::string(capacity, 'y'));
+  write(b, "tail");
+  assert(b.size() == capacity + 4);
+  assert(std::memcmp(static_cast<const char*>(b.data().data()) + capacity, "tail", 4) == 0);
+
+  std::cout << "capacity " << capacity << " --> " << b.capacity() << '\n';
+  return 0;
+}
+}  // namespace test_ring_streambuf
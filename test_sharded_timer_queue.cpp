@@ -0,0 +1,100 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "basic_waitable_timer.hpp"
+#include "post.hpp"
+#include "thread_group.hpp"
+
+// ʱа̷ֳ߳4Ƭʱ
+struct sharded_clock
+{
+  using rep = std::chrono::steady_clock::rep;
+  using period = std::chrono::steady_clock::period;
+  using duration = std::chrono::steady_clock::duration;
+  using time_point = std::chrono::steady_clock::time_point;
+  static const bool is_steady = true;
+  static time_point now() { return std::chrono::steady_clock::now(); }
+};
+
+namespace boost::asio::detail {
+template <>
+struct timer_queue_traits<sharded_clock>
+{
+  enum
+  {
+    use_timing_wheel = 0,
+    heap_arity = 4,
+    timer_shards = 4
+  };
+
+  static std::chrono::nanoseconds tick() { return std::chrono::milliseconds(1); }
+};
+}  // namespace boost::asio::detail
+
+namespace test_sharded_timer_queue {
+
+using namespace boost::asio;
+using timer = basic_waitable_timer<sharded_clock>;
+
+int main()
+{
+  io_context ioc;
+  const int threads_count = 4;
+  const int n = 4000;
+
+  // żʱ20msڵ ʱ10sڣɱ߳ȡ
+  std::vector<std::unique_ptr<timer>> timers;
+  for (int i = 0; i < n; ++i) {
+    auto expiry = i % 2 ? std::chrono::seconds(10) : std::chrono::steady_clock::duration(std::chrono::milliseconds(i % 20));
+    timers.emplace_back(new timer(ioc, expiry));
+  }
+
+  std::atomic<int> completed(0);
+  std::atomic<int> aborted(0);
+  std::atomic<int> started(0);
+  auto on_wait = [&](const std::error_code& ec) {
+    if (ec) {
+      ++aborted;
+    } else {
+      ++completed;
+    }
+  };
+
+  // ÿ̷߳һȴ䵽ԵķƬȫһ߳ȡʱ
+  for (int t = 0; t < threads_count; ++t) {
+    post(ioc, [&, t]() {
+      for (int i = t; i < n; i += threads_count) {
+        timers[i]->async_wait(on_wait);
+      }
+      if (++started == threads_count) {
+        post(ioc, [&]() {
+          for (int i = 1; i < n; i += 2) {
+            timers[i]->cancel();
+          }
+        });
+      }
+    });
+  }
+
+  detail::thread_group threads;
+  threads.create_thread([&]() { ioc.run(); }, threads_count);
+  threads.join();
+
+  assert(completed == n / 2);
+  assert(aborted == n / 2);
+  std::cout << "completed " << completed << " aborted " << aborted << '\n';
+
+  // reactorرպƬвٽܵȴ ڶ
+  {
+    io_context ioc2;
+    timer t(ioc2, std::chrono::seconds(10));
+    ioc2.shutdown();
+    t.async_wait([](const std::error_code&) {});
+    assert(t.cancel() == 0);
+  }
+  return 0;
+}
+}  // namespace test_sharded_timer_queue
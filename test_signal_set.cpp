@@ -0,0 +1,65 @@
+#include <signal.h>
+#include <unistd.h>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include "signal_set.hpp"
+#include "thread_group.hpp"
+
+namespace test_signal_set {
+
+using namespace boost::asio;
+
+int main()
+{
+  io_context ioc;
+  signal_set signals(ioc, SIGHUP, SIGUSR1);
+
+  // ȴߴSIGHUPٴεȴ ڼ䵽SIGUSR1¼
+  int received = 0;
+  std::function<void(const std::error_code&, int)> on_signal;
+  on_signal = [&](const std::error_code& ec, int signal_number) {
+    assert(!ec);
+    std::cout << "signal " << signal_number << (signal_number == SIGHUP ? " reload config\n" : "\n");
+    if (++received < 2) {
+      signals.async_wait(on_signal);
+    }
+  };
+  signals.async_wait(on_signal);
+  ::kill(::getpid(), SIGHUP);
+  ::kill(::getpid(), SIGUSR1);
+
+  // ̴̳߳߳ʱȫź źֻͨsignalfd
+  detail::thread_group threads;
+  threads.create_thread([&]() { ioc.run(); }, 2);
+  threads.join();
+  assert(received == 2);
+
+  // cancelõȴoperation_aborted
+  ioc.restart();
+  signals.async_wait([](const std::error_code& ec, int) { std::cout << "cancel: " << ec.message() << '\n'; });
+  signals.cancel();
+  ioc.run();
+
+  // ߳add ߳ûSIGUSR2յʱתsignalfd
+  ioc.restart();
+  signal_set pool_signals(ioc);
+  std::thread([&] { pool_signals.add(SIGUSR2); }).join();
+  int forwarded = 0;
+  pool_signals.async_wait([&](const std::error_code& ec, int signal_number) {
+    assert(!ec && signal_number == SIGUSR2);
+    ++forwarded;
+  });
+  ::kill(::getpid(), SIGUSR2);
+  ioc.run();
+  assert(forwarded == 1);
+
+  // һעƳָĬϴʽ
+  pool_signals.remove(SIGUSR2);
+  struct sigaction action;
+  ::sigaction(SIGUSR2, 0, &action);
+  assert(action.sa_handler == SIG_DFL);
+  return 0;
+}
+}  // namespace test_signal_set
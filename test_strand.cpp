@@ -0,0 +1,316 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "executor_work_guard.hpp"
+#include "io_context.hpp"
+#include "recycling_allocator.hpp"
+#include "strand.hpp"
+#include "thread_group.hpp"
+
+namespace test_strand {
+
+using namespace boost::asio;
+using strand_type = strand<io_context::executor_type>;
+
+enum
+{
+  num_producers = 4
+};
+
+// ÿstrandļ״̬: ͬʱֻһִУͬһߵĴͶ˳ִ
+struct session
+{
+  explicit session(io_context& ioc) : strand_(ioc.get_executor()), inside_(false), count_(0)
+  {
+    for (int i = 0; i < num_producers; ++i) {
+      last_[i] = -1;
+    }
+  }
+
+  strand_type strand_;
+  std::atomic<bool> inside_;
+  int last_[num_producers];
+  int count_;
+};
+
+// һ߳ÿstrandͶϢstrand̵ܴ߳
+std::size_t count_migrations(bool affinity)
+{
+  io_context ioc;
+  set_strand_affinity(ioc, affinity);
+  std::vector<std::unique_ptr<strand_type>> strands;
+  for (int i = 0; i < 200; ++i) {
+    strands.emplace_back(new strand_type(ioc.get_executor()));
+  }
+
+  auto work = make_work_guard(ioc);
+  detail::thread_group runners;
+  runners.create_thread([&] { ioc.run(); }, 4);
+
+  std::atomic<int> done(0);
+  for (int round = 0; round < 50; ++round) {
+    for (auto& s : strands) {
+      s->post([&] { ++done; }, detail::recycling_allocator<void>());
+    }
+  }
+  while (done != 50 * 200) {
+    std::this_thread::yield();
+  }
+  work.reset();
+  runners.join();
+
+  std::size_t total = 0;
+  for (auto& s : strands) {
+    total += s->migrations();
+  }
+  assert(total == ioc.statistics().strands.migrations);
+  return total;
+}
+
+int main()
+{
+  io_context ioc;
+  const int sessions_count = 1000;
+  const int per_producer = 100;
+
+  std::vector<std::unique_ptr<session>> sessions;
+  for (int i = 0; i < sessions_count; ++i) {
+    sessions.emplace_back(new session(ioc));
+  }
+
+  auto work = make_work_guard(ioc);
+  detail::thread_group runners;
+  runners.create_thread([&] { ioc.run(); }, 4);
+
+  std::atomic<int> errors(0);
+  std::atomic<int> dispatched(0);
+  auto start = std::chrono::steady_clock::now();
+  detail::thread_group producers;
+  for (int p = 0; p < num_producers; ++p) {
+    producers.create_thread([&, p] {
+      detail::recycling_allocator<void> alloc;
+      for (int n = 0; n < per_producer; ++n) {
+        for (auto& s : sessions) {
+          session* sp = s.get();
+          sp->strand_.post(
+              [&, sp, p, n] {
+                if (sp->inside_.exchange(true) || !sp->strand_.running_in_this_thread() || sp->last_[p] != n - 1) {
+                  ++errors;
+                }
+                sp->last_[p] = n;
+                ++sp->count_;
+
+                // stranddispatchֱִ
+                bool inline_call = false;
+                sp->strand_.dispatch([&] { inline_call = true; }, detail::recycling_allocator<void>());
+                if (inline_call) {
+                  ++dispatched;
+                }
+                sp->inside_ = false;
+              },
+              alloc);
+        }
+      }
+    });
+  }
+  producers.join();
+  work.reset();
+  runners.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  int total = 0;
+  for (auto& s : sessions) {
+    total += s->count_;
+    assert(!s->strand_.running_in_this_thread());
+  }
+  assert(errors == 0);
+  assert(total == sessions_count * per_producer * num_producers);
+  assert(dispatched == total);
+
+  // ÿһstrand٣strand_implӶظ
+  {
+    detail::strand_executor_service& service = use_service<detail::strand_executor_service>(ioc);
+    std::size_t capacity = service.pool_capacity();
+    for (int i = 0; i < 10000; ++i) {
+      strand_type s(ioc.get_executor());
+      strand_type copy(s);
+      assert(copy == s);
+    }
+    assert(service.pool_capacity() == capacity);
+  }
+
+  // δеio_contextʱstrandŶӵĴٶִ
+  {
+    io_context idle;
+    strand_type s(idle.get_executor());
+    std::shared_ptr<int> token = std::make_shared<int>(0);
+    for (int i = 0; i < 10; ++i) {
+      s.post([token] { ++*token; }, detail::recycling_allocator<void>());
+    }
+    assert(token.use_count() == 11);
+  }
+
+  // Ԥ: æstrandÿִ10ọ́߳Ͷݵstrandصȫִ
+  {
+    io_context ioc2;
+    set_strand_budget(ioc2, 10);
+    strand_type busy(ioc2.get_executor());
+    strand_type quiet(ioc2.get_executor());
+    int busy_done = 0;
+    int busy_done_before_quiet = -1;
+    for (int i = 0; i < 100; ++i) {
+      busy.post(
+          [&] {
+            if (++busy_done == 2) {  // ڶĵһʱbusyinvokerִ
+              quiet.post([&] { busy_done_before_quiet = busy_done; }, detail::recycling_allocator<void>());
+            }
+          },
+          detail::recycling_allocator<void>());
+    }
+    ioc2.run();
+    assert(busy_done == 100);
+    assert(busy_done_before_quiet == 11);
+    assert(ioc2.statistics().strands.handler_budget_hits == 9);
+
+    // ʱ: ÿʱԤ һinvokerֻʱ14ÿִ1
+    ioc2.restart();
+    ioc2.reset_statistics();
+    set_strand_budget(ioc2, 0, std::chrono::microseconds(100));
+    for (int i = 0; i < 5; ++i) {
+      busy.post([] { std::this_thread::sleep_for(std::chrono::microseconds(200)); }, detail::recycling_allocator<void>());
+    }
+    ioc2.run();
+    strand_statistics stats = ioc2.statistics().strands;
+    assert(stats.handlers == 5);
+    assert(stats.invocations == 5);
+    assert(stats.time_budget_hits == 3);
+    assert(stats.handler_budget_hits == 0);
+  }
+
+  // ׺ģʽͶݣÿصһִе߳
+  {
+    io_context ioc3;
+    set_strand_affinity(ioc3, true);
+    strand_type s(ioc3.get_executor());
+    auto work3 = make_work_guard(ioc3);
+    detail::thread_group runners3;
+    runners3.create_thread([&] { ioc3.run(); }, 4);
+
+    std::thread::id first;
+    std::atomic<int> same(0);
+    for (int i = 0; i < 100; ++i) {
+      std::atomic<bool> done(false);
+      s.post(
+          [&] {
+            if (first == std::thread::id()) {
+              first = std::this_thread::get_id();
+            }
+            if (first == std::this_thread::get_id()) {
+              ++same;
+            }
+            done = true;
+          },
+          detail::recycling_allocator<void>());
+      while (!done) {
+        std::this_thread::yield();
+      }
+    }
+    work3.reset();
+    runners3.join();
+    assert(same == 100);
+    assert(s.migrations() == 0);
+  }
+
+  // ׺ģʽԤóʱ빫УͶݵstrandͬصȷæstrandִ
+  {
+    io_context ioc4;
+    set_strand_affinity(ioc4, true);
+    set_strand_budget(ioc4, 10);
+    strand_type busy(ioc4.get_executor());
+    strand_type quiet(ioc4.get_executor());
+    int busy_done = 0;
+    int busy_done_before_quiet = -1;
+    for (int i = 0; i < 100; ++i) {
+      busy.post(
+          [&] {
+            if (++busy_done == 2) {
+              quiet.post([&] { busy_done_before_quiet = busy_done; }, detail::recycling_allocator<void>());
+            }
+          },
+          detail::recycling_allocator<void>());
+    }
+    ioc4.run();
+    assert(busy_done == 100);
+    assert(busy_done_before_quiet == 11);
+  }
+
+  // Ŀ߳̿ڳʱ ߳ȡ׺ͶĲ
+  {
+    io_context ioc5;
+    set_strand_affinity(ioc5, true);
+    strand_type blocker(ioc5.get_executor());
+    strand_type s(ioc5.get_executor());
+    auto work5 = make_work_guard(ioc5);
+    detail::thread_group runners5;
+    runners5.create_thread([&] { ioc5.run(); }, 2);
+
+    // sdispatchblocker߳ϵһִ ׺͵ͬһ߳
+    std::atomic<bool> ready(false);
+    std::thread::id stuck;
+    blocker.post(
+        [&] {
+          stuck = std::this_thread::get_id();
+          s.dispatch([&] { ready = true; }, detail::recycling_allocator<void>());
+        },
+        detail::recycling_allocator<void>());
+    while (!ready) {
+      std::this_thread::yield();
+    }
+
+    std::atomic<bool> started(false);
+    std::atomic<bool> released(false);
+    blocker.post(
+        [&] {
+          started = true;
+          auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+          while (!released && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+          }
+        },
+        detail::recycling_allocator<void>());
+    while (!started) {
+      std::this_thread::yield();
+    }
+
+    std::thread::id thief;
+    auto posted = std::chrono::steady_clock::now();
+    s.post(
+        [&] {
+          thief = std::this_thread::get_id();
+          released = true;
+        },
+        detail::recycling_allocator<void>());
+    while (!released) {
+      std::this_thread::yield();
+    }
+    auto waited = std::chrono::steady_clock::now() - posted;
+    work5.reset();
+    runners5.join();
+    assert(thief != stuck);
+    assert(waited < std::chrono::seconds(1));
+    assert(s.migrations() == 1);
+  }
+
+  std::size_t shared_migrations = count_migrations(false);
+  std::size_t affine_migrations = count_migrations(true);
+  std::cout << "migrations " << shared_migrations << " --> " << affine_migrations << '\n';
+
+  std::cout << sessions_count << " strands " << total << " handlers "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms\n";
+  return 0;
+}
+}  // namespace test_strand
@@ -0,0 +1,64 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include "read_until.hpp"
+#include "ring_streambuf.hpp"
+#include "stream_descriptor.hpp"
+
+namespace test_stream_descriptor {
+
+using namespace boost::asio;
+
+int main()
+{
+  io_context ioc;
+  posix::stream_descriptor in(ioc), out(ioc);
+  posix::connect_pipe(in, out);
+
+  // ȵȴɶ д
+  bool readable = false;
+  in.async_wait(posix::stream_descriptor::wait_read, [&](const std::error_code& ec) {
+    assert(!ec);
+    readable = true;
+  });
+
+  std::string msg("hello\nworld\n");
+  out.async_write_some(buffer(msg), [&](const std::error_code& ec, std::size_t n) {
+    assert(!ec && n == msg.size());
+    std::cout << "write " << n << '\n';
+  });
+  ioc.run();
+  assert(readable);
+
+  // ض: ݵʱȡ
+  ioc.restart();
+  in.async_read_some([&](const std::error_code& ec, pooled_buffer b, std::size_t n) {
+    assert(!ec);
+    std::cout << "pooled read " << std::string(static_cast<char*>(b.data()), n);
+  });
+  ioc.run();
+
+  // ָ д˹رպõeof
+  ioc.restart();
+  ring_streambuf sb(4096);
+  async_read_until(in, sb, '\n', [&](const std::error_code& ec, std::size_t n) {
+    std::cout << "read_until " << ec.message() << " " << n << '\n';
+  });
+  out.write_some(buffer(std::string("line\n")));
+  ioc.run();
+
+  ioc.restart();
+  out.close();
+  char buf[16];
+  in.async_read_some(buffer(buf), [&](const std::error_code& ec, std::size_t n) {
+    assert(ec == detail::error_code::eof && n == 0);
+    std::cout << "after close: " << ec.message() << '\n';
+  });
+  ioc.run();
+
+  int fd = in.release();
+  assert(fd != -1 && !in.is_open());
+  ::close(fd);
+  return 0;
+}
+}  // namespace test_stream_descriptor
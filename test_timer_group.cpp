@@ -0,0 +1,101 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "dary_timer_queue.hpp"
+#include "steady_timer.hpp"
+#include "timer_queue.hpp"
+#include "timing_wheel.hpp"
+
+namespace test_timer_group {
+
+using namespace boost::asio;
+using clock_type = std::chrono::steady_clock;
+using traits = detail::chrono_time_traits<clock_type, wait_traits<clock_type>>;
+
+struct group_op : detail::wait_op
+{
+  group_op() : detail::wait_op(&group_op::do_complete), index_(0) {}
+  static void do_complete(void*, detail::operation*, const std::error_code&, std::size_t) {}
+  std::size_t index_;
+};
+
+// һ붨ʱڷ1 ȡʣµİʱ˳
+template <typename Queue>
+void check_queue(bool ordered)
+{
+  const std::size_t n = 1000;
+  clock_type::time_point now = clock_type::now();  // ʱֵ㣬ȫѾ
+  Queue queue;
+  std::vector<typename Queue::per_timer_data> timers(n);
+  std::vector<group_op> ops(n);
+  std::vector<clock_type::time_point> times(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    times[i] = now - std::chrono::microseconds((i * 7919) % n + 1);
+    timers[i].set_group(i % 2 ? 1 : 2);
+    ops[i].index_ = i;
+    queue.enqueue_timer(times[i], timers[i], &ops[i]);
+  }
+
+  detail::op_queue<detail::operation> cancelled;
+  assert(queue.cancel_group(1, cancelled) == n / 2);
+  std::size_t count = 0;
+  while (detail::operation* op = cancelled.front()) {
+    cancelled.pop();
+    group_op* o = static_cast<group_op*>(op);
+    assert(o->index_ % 2 == 1);
+    assert(o->ec_ == detail::error_code::operation_aborted);
+    ++count;
+  }
+  assert(count == n / 2);
+
+  detail::op_queue<detail::operation> ready;
+  queue.get_ready_timers(ready);
+  count = 0;
+  clock_type::time_point last = clock_type::time_point::min();
+  while (detail::operation* op = ready.front()) {
+    ready.pop();
+    group_op* o = static_cast<group_op*>(op);
+    assert(o->index_ % 2 == 0);
+    assert(!ordered || !(times[o->index_] < last));
+    last = times[o->index_];
+    ++count;
+  }
+  assert(count == n / 2);
+  assert(queue.empty());
+}
+
+int main()
+{
+  check_queue<detail::timer_queue<traits>>(true);
+  check_queue<detail::dary_timer_queue<traits, 4>>(true);
+  check_queue<detail::dary_timer_queue<traits, 8>>(true);
+  check_queue<detail::timing_wheel<traits>>(false);
+
+  // ͨio_contextȡ
+  io_context ioc;
+  std::vector<std::unique_ptr<steady_timer>> timers;
+  int completed = 0, aborted = 0;
+  for (int i = 0; i < 200; ++i) {
+    timers.emplace_back(new steady_timer(ioc));
+    if (i % 2) {
+      timers.back()->set_group(7);
+      timers.back()->expires_after(std::chrono::seconds(10));
+    } else {
+      timers.back()->expires_after(std::chrono::milliseconds(i / 10));
+    }
+    timers.back()->async_wait([&](const std::error_code& ec) { ec ? ++aborted : ++completed; });
+  }
+  assert(timers[1]->group() == 7);
+  assert(cancel_timer_group<clock_type>(ioc, 7) == 100);
+  assert(cancel_timer_group<clock_type>(ioc, 0) == 0);
+  clock_type::time_point start = clock_type::now();
+  ioc.run();
+  assert(completed == 100 && aborted == 100);
+  assert(clock_type::now() - start < std::chrono::seconds(1));
+
+  std::cout << "completed " << completed << " aborted " << aborted << '\n';
+  return 0;
+}
+}  // namespace test_timer_group
@@ -0,0 +1,100 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "dary_timer_queue.hpp"
+#include "timer_queue.hpp"
+#include "timing_wheel.hpp"
+
+namespace test_timer_queue_bench {
+
+using namespace boost::asio;
+
+// ֶƽʱ ųϵͳõӰ
+struct manual_traits
+{
+  using clock_type = std::chrono::steady_clock;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<std::chrono::steady_clock, duration>;
+
+  static time_point current;
+  static time_point now() { return current; }
+  static duration subtract(const time_point& t1, const time_point& t2) { return t1 - t2; }
+  static bool less_than(const time_point& t1, const time_point& t2) { return t1 < t2; }
+  static std::chrono::nanoseconds to_chrono_duration(const duration& d) { return d; }
+};
+manual_traits::time_point manual_traits::current;
+
+struct bench_op : detail::wait_op
+{
+  bench_op() : detail::wait_op(&bench_op::do_complete) {}
+  static void do_complete(void*, detail::operation*, const std::error_code&, std::size_t) {}
+  manual_traits::time_point expiry_;
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// nʱn(гʱĵ÷)ȫȡ
+template <typename Queue>
+void bench(const char* name, std::size_t n, bool sorted)
+{
+  std::mt19937_64 rng(n);
+  const std::int64_t range = 60ll * 1000 * 1000 * 1000;  // 60ڵ
+  manual_traits::current = manual_traits::time_point();
+
+  Queue q;
+  std::vector<typename Queue::per_timer_data> timers(n);
+  std::vector<bench_op> ops(n);
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < n; ++i) {
+    ops[i].expiry_ = manual_traits::time_point(std::chrono::nanoseconds(rng() % range));
+    q.enqueue_timer(ops[i].expiry_, timers[i], &ops[i]);
+  }
+  double insert_ms = elapsed_ms(start);
+
+  start = std::chrono::steady_clock::now();
+  detail::op_queue<detail::operation> cancelled;
+  for (std::size_t k = 0; k < n; ++k) {
+    std::size_t i = rng() % n;
+    q.cancel_timer(timers[i], cancelled);
+    cancelled.pop();
+    ops[i].expiry_ = manual_traits::time_point(std::chrono::nanoseconds(rng() % range));
+    q.enqueue_timer(ops[i].expiry_, timers[i], &ops[i]);
+  }
+  double rearm_ms = elapsed_ms(start);
+
+  start = std::chrono::steady_clock::now();
+  manual_traits::current = manual_traits::time_point(std::chrono::nanoseconds(range));
+  detail::op_queue<detail::operation> ready;
+  q.get_ready_timers(ready);
+  double drain_ms = elapsed_ms(start);
+
+  std::size_t count = 0;
+  manual_traits::time_point last;
+  while (bench_op* op = static_cast<bench_op*>(ready.front())) {
+    ready.pop();
+    assert(!sorted || !(op->expiry_ < last));
+    last = op->expiry_;
+    ++count;
+  }
+  assert(count == n && q.empty());
+  std::printf("%-16s n=%-9zu insert %8.1fms  rearm %8.1fms  drain %8.1fms\n", name, n, insert_ms, rearm_ms, drain_ms);
+}
+
+int main()
+{
+  const std::size_t sizes[] = {10000, 1000000, 10000000};
+  for (std::size_t n : sizes) {
+    bench<detail::timer_queue<manual_traits>>("binary heap", n, true);
+    bench<detail::dary_timer_queue<manual_traits, 4>>("4-ary heap", n, true);
+    bench<detail::dary_timer_queue<manual_traits, 8>>("8-ary heap", n, true);
+    bench<detail::timing_wheel<manual_traits>>("timing wheel", n, false);
+  }
+  return 0;
+}
+}  // namespace test_timer_queue_bench
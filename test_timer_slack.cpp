@@ -0,0 +1,49 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "steady_timer.hpp"
+
+namespace test_timer_slack {
+
+using namespace boost::asio;
+
+int main()
+{
+  io_context ioc;
+  const int n = 1000;
+  const auto slack = std::chrono::nanoseconds(1 << 22);
+
+  // 1000ʱ2ms½ slackԼ4msʱϲͬһڣһʱҲȵһں
+  auto now = std::chrono::steady_clock::now();
+  auto start = now - now.time_since_epoch() % slack + slack + std::chrono::microseconds(100);
+  auto last = start + std::chrono::microseconds(2 * (n - 1));
+
+  std::vector<std::unique_ptr<steady_timer>> timers;
+  std::chrono::steady_clock::time_point first_completion = std::chrono::steady_clock::time_point::max();
+  int completed = 0;
+  for (int i = 0; i < n; ++i) {
+    timers.emplace_back(new steady_timer(ioc, start + std::chrono::microseconds(2 * i)));
+    steady_timer& t = *timers.back();
+    t.set_slack(slack);
+    assert(t.slack() == slack);
+    t.async_wait([&t, &first_completion, &completed](const std::error_code& ec) {
+      assert(!ec);
+      auto now = std::chrono::steady_clock::now();
+      assert(now >= t.expiry());
+      if (now < first_completion) {
+        first_completion = now;
+      }
+      ++completed;
+    });
+  }
+  ioc.run();
+  assert(completed == n);
+  assert(first_completion >= last);
+  std::cout << n << " timers completed "
+            << std::chrono::duration_cast<std::chrono::microseconds>(first_completion - start).count()
+            << "us after the first expiry\n";
+  return 0;
+}
+}  // namespace test_timer_slack
@@ -0,0 +1,76 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "epoll_reactor.hpp"
+#include "steady_timer.hpp"
+#include "strand_executor_service.hpp"
+
+namespace test_timer_statistics {
+
+using namespace boost::asio;
+
+int main()
+{
+  // λֵ1/32
+  hdr_histogram h;
+  for (int i = 1; i <= 100000; ++i) {
+    h.record(i);
+  }
+  assert(h.count() == 100000);
+  assert(h.max() == 100000);
+  std::uint64_t p50 = h.value_at_percentile(50);
+  assert(p50 >= 50000 && p50 <= 50000 + 50000 / 32);
+  assert(h.value_at_percentile(100) == 100000);
+
+  // ȡͳƲ
+  io_context idle;
+  assert(idle.statistics().timers.lateness.count() == 0);
+  idle.reset_statistics();
+  assert(!has_service<detail::epoll_reactor>(idle));
+  assert(!has_service<detail::strand_executor_service>(idle));
+
+  // Ĭϲ¼
+  io_context quiet;
+  steady_timer quiet_timer(quiet, std::chrono::milliseconds(1));
+  quiet_timer.async_wait([](const std::error_code& ec) { assert(!ec); });
+  quiet.run();
+  assert(quiet.statistics().timers.lateness.count() == 0);
+  assert(quiet.statistics().timers.queue_delay.count() == 0);
+
+  io_context ioc;
+  ioc.enable_timer_statistics();
+  std::vector<std::unique_ptr<steady_timer>> timers;
+  int completed = 0;
+  for (int i = 0; i < 100; ++i) {
+    timers.emplace_back(new steady_timer(ioc, std::chrono::microseconds(500 * i)));
+    timers.back()->async_wait([&](const std::error_code& ec) {
+      assert(!ec);
+      // һhandler 浽ڵĶʱŶӵȴ
+      if (completed++ == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    });
+  }
+  ioc.run();
+  assert(completed == 100);
+
+  io_context_statistics stats = ioc.statistics();
+  assert(stats.timers.lateness.count() == 100);
+  assert(stats.timers.queue_delay.count() == 100);
+  assert(stats.timers.heap_size.count() > 0);
+  assert(stats.timers.heap_size.max() <= 100);
+  assert(stats.timers.lateness.max() > 1000000);
+
+  ioc.reset_statistics();
+  assert(ioc.statistics().timers.lateness.count() == 0);
+
+  std::cout << "lateness p50 " << stats.timers.lateness.value_at_percentile(50) << "ns p99 "
+            << stats.timers.lateness.value_at_percentile(99) << "ns, queue delay p99 "
+            << stats.timers.queue_delay.value_at_percentile(99) << "ns, heap size max " << stats.timers.heap_size.max()
+            << '\n';
+  return 0;
+}
+}  // namespace test_timer_statistics
@@ -0,0 +1,77 @@
+#include <time.h>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "coarse_steady_timer.hpp"
+#include "steady_timer.hpp"
+
+namespace test_timer_sync_wait {
+
+using namespace boost::asio;
+using clock_type = std::chrono::steady_clock;
+
+std::chrono::nanoseconds thread_cpu_time()
+{
+  timespec ts;
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+int main()
+{
+  io_context ioc;
+
+  // ʱȴ ͳƳʱ
+  steady_timer timer(ioc);
+  clock_type::duration oversleep(0);
+  for (int i = 0; i < 20; ++i) {
+    timer.expires_after(std::chrono::microseconds(500));
+    timer.wait();
+    clock_type::duration late = clock_type::now() - timer.expiry();
+    assert(late >= clock_type::duration::zero());
+    if (late > oversleep) {
+      oversleep = late;
+    }
+  }
+
+  basic_waitable_timer<std::chrono::system_clock> sys_timer(ioc, std::chrono::milliseconds(2));
+  sys_timer.wait();
+  assert(std::chrono::system_clock::now() >= sys_timer.expiry());
+
+  // ߳cancelwait
+  timer.expires_after(std::chrono::seconds(10));
+  std::size_t cancelled = 0;
+  std::thread t([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cancelled = timer.cancel();
+  });
+  clock_type::time_point start = clock_type::now();
+  std::error_code ec;
+  timer.wait(ec);
+  t.join();
+  assert(ec == detail::error_code::operation_aborted);
+  assert(cancelled == 1);
+  assert(clock_type::now() - start < std::chrono::seconds(1));
+
+  // ȶʱʱʱѾ߹ʱ ת
+  coarse_steady_timer coarse(ioc);
+  std::chrono::nanoseconds cpu = thread_cpu_time();
+  for (int i = 0; i < 20; ++i) {
+    coarse.expires_after(std::chrono::milliseconds(10));
+    coarse.wait();
+    assert(coarse_steady_clock::now() >= coarse.expiry());
+  }
+  cpu = thread_cpu_time() - cpu;
+  assert(cpu < std::chrono::milliseconds(20));
+
+  // Ѿʱֱӷ
+  timer.expires_at(clock_type::now());
+  timer.wait(ec);
+  assert(!ec);
+
+  std::cout << "max oversleep " << std::chrono::duration_cast<std::chrono::microseconds>(oversleep).count()
+            << "us\n";
+  return 0;
+}
+}  // namespace test_timer_sync_wait
@@ -0,0 +1,133 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "basic_waitable_timer.hpp"
+#include "timing_wheel.hpp"
+
+// ʹʱֵʱ
+struct wheel_clock
+{
+  using rep = std::chrono::steady_clock::rep;
+  using period = std::chrono::steady_clock::period;
+  using duration = std::chrono::steady_clock::duration;
+  using time_point = std::chrono::steady_clock::time_point;
+  static const bool is_steady = true;
+  static time_point now() { return std::chrono::steady_clock::now(); }
+};
+
+namespace boost::asio::detail {
+template <>
+struct timer_queue_traits<wheel_clock>
+{
+  enum
+  {
+    use_timing_wheel = 1,
+    heap_arity = 2,
+    timer_shards = 0
+  };
+
+  static std::chrono::nanoseconds tick() { return std::chrono::microseconds(500); }
+};
+}  // namespace boost::asio::detail
+
+namespace test_timing_wheel {
+
+using namespace boost::asio;
+
+// ֶƽʱ
+struct manual_traits
+{
+  using clock_type = std::chrono::steady_clock;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<std::chrono::steady_clock, duration>;
+
+  static time_point current;
+  static time_point now() { return current; }
+  static duration subtract(const time_point& t1, const time_point& t2) { return t1 - t2; }
+  static std::chrono::nanoseconds to_chrono_duration(const duration& d) { return d; }
+};
+manual_traits::time_point manual_traits::current;
+
+struct test_op : detail::wait_op
+{
+  test_op() : detail::wait_op(&test_op::do_complete), fired_(0) {}
+  static void do_complete(void*, detail::operation*, const std::error_code&, std::size_t) {}
+  manual_traits::time_point expiry_;
+  int fired_;
+};
+
+int main()
+{
+  using wheel = detail::timing_wheel<manual_traits>;
+  const std::size_t n = 100000;
+  std::mt19937_64 rng(42);
+
+  // ʱ1ms첻 ÿ3ȡһ
+  wheel q(std::chrono::milliseconds(1));
+  std::vector<wheel::per_timer_data> timers(n);
+  std::vector<test_op> ops(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::int64_t ns = static_cast<std::int64_t>(rng() % (1ull << (20 + i % 28)));
+    ops[i].expiry_ = manual_traits::current + std::chrono::nanoseconds(ns);
+    q.enqueue_timer(ops[i].expiry_, timers[i], &ops[i]);
+  }
+  detail::op_queue<detail::operation> cancelled;
+  for (std::size_t i = 0; i < n; i += 3) {
+    assert(q.cancel_timer(timers[i], cancelled) == 1);
+  }
+  while (cancelled.front()) {
+    cancelled.pop();
+  }
+
+  // ƽʱ ÿʱڵںĵһƽд
+  std::size_t fired = 0;
+  std::size_t steps = 0;
+  while (!q.empty()) {
+    manual_traits::time_point prev = manual_traits::current;
+    long usec = q.wait_duration_usec(std::numeric_limits<long>::max());
+    manual_traits::current += std::chrono::microseconds(usec) + std::chrono::nanoseconds(rng() % 1000000);
+    detail::op_queue<detail::operation> ready;
+    q.get_ready_timers(ready);
+    while (test_op* op = static_cast<test_op*>(ready.front())) {
+      ready.pop();
+      assert(op->expiry_ <= manual_traits::current);
+      assert(op->expiry_ > prev - std::chrono::milliseconds(1));
+      ++op->fired_;
+      ++fired;
+    }
+    ++steps;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    assert(ops[i].fired_ == (i % 3 == 0 ? 0 : 1));
+  }
+  std::cout << "fired " << fired << " in " << steps << " steps\n";
+
+  // timer_queue_traits<wheel_clock>ػbasic_waitable_timer<wheel_clock>ʹʱ
+  io_context ioc;
+  std::vector<std::unique_ptr<basic_waitable_timer<wheel_clock>>> wheel_timers;
+  int completed = 0;
+  int aborted = 0;
+  for (int i = 0; i < 1000; ++i) {
+    wheel_timers.emplace_back(new basic_waitable_timer<wheel_clock>(ioc, std::chrono::microseconds(rng() % 50000)));
+    basic_waitable_timer<wheel_clock>& t = *wheel_timers.back();
+    t.async_wait([&t, &completed, &aborted](const std::error_code& ec) {
+      if (ec) {
+        ++aborted;
+      } else {
+        assert(wheel_clock::now() >= t.expiry());
+        ++completed;
+      }
+    });
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    wheel_timers[i]->cancel();
+  }
+  ioc.run();
+  assert(completed == 500 && aborted == 500);
+  std::cout << "completed " << completed << " aborted " << aborted << '\n';
+  return 0;
+}
+}  // namespace test_timing_wheel
@@ -1,3 +1,4 @@
+#include <cassert>
 #include <iostream>
 #include "steady_timer.hpp"
 
@@ -15,6 +16,9 @@ int main()
   t.wait();
   std::cout << "hello,world!\n";
 
+  // ûеȴʱcancelɹ0 쳣
+  assert(t.cancel() == 0);
+
   return 0;
 }
 }  // namespace test_wait
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "post.hpp"
+#include "stream_descriptor.hpp"
+#include "with_timeout.hpp"
+
+namespace test_with_timeout {
+
+using namespace boost::asio;
+using clock_type = std::chrono::steady_clock;
+
+// cancelɹĲ󣬵һִ߳ŷ
+struct slow_object
+{
+  explicit slow_object(io_context& ioc) : ioc_(ioc), other_ran_(false), ran_during_cancel_(false), cancel_returned_(false)
+  {}
+
+  io_context::executor_type get_executor() { return ioc_.get_executor(); }
+
+  template <typename Handler>
+  void async_wait(Handler&& handler)
+  {
+    pending_ = std::forward<Handler>(handler);
+  }
+
+  void cancel()
+  {
+    post(ioc_, std::bind(std::move(pending_), std::error_code(detail::error_code::operation_aborted)));
+    post(ioc_, [this] { other_ran_ = true; });
+    clock_type::time_point deadline = clock_type::now() + std::chrono::seconds(1);
+    while (!other_ran_ && clock_type::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ran_during_cancel_ = other_ran_.load();
+    cancel_returned_ = true;
+  }
+
+  io_context& ioc_;
+  std::function<void(std::error_code)> pending_;
+  std::atomic<bool> other_ran_;
+  std::atomic<bool> ran_during_cancel_;
+  std::atomic<bool> cancel_returned_;
+};
+
+std::atomic<int> allocations(0), live_allocations(0);
+
+// ¼handler
+template <typename T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&)
+  {}
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    ++live_allocations;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --live_allocations;
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+struct handoff_handler
+{
+  using allocator_type = counting_allocator<void>;
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  void operator()(const std::error_code& ec) const
+  {
+    assert(ec == std::errc::timed_out);
+    assert(obj_->cancel_returned_);
+    *handed_off_ = true;
+  }
+
+  slow_object* obj_;
+  bool* handed_off_;
+};
+
+int main()
+{
+  io_context ioc;
+  posix::stream_descriptor in(ioc), out(ioc);
+  posix::connect_pipe(in, out);
+  char data[64];
+
+  // û ʱtimed_out
+  clock_type::time_point start = clock_type::now();
+  bool timed_out = false;
+  in.async_read_some(buffer(data, sizeof(data)),
+                     with_timeout(in, std::chrono::milliseconds(20), [&](const std::error_code& ec, std::size_t n) {
+                       assert(ec == std::errc::timed_out);
+                       assert(n == 0);
+                       timed_out = true;
+                     }));
+  ioc.run();
+  assert(timed_out);
+  assert(clock_type::now() - start >= std::chrono::milliseconds(20));
+
+  // ʱǰ ʱȡrunȵʱ
+  ioc.restart();
+  start = clock_type::now();
+  std::string msg("hello");
+  std::size_t read = 0;
+  in.async_read_some(buffer(data, sizeof(data)),
+                     with_timeout(in, std::chrono::seconds(10), [&](const std::error_code& ec, std::size_t n) {
+                       assert(!ec);
+                       read = n;
+                     }));
+  out.async_write_some(buffer(msg), [](const std::error_code& ec, std::size_t) { assert(!ec); });
+  ioc.run();
+  assert(read == msg.size());
+  assert(clock_type::now() - start < std::chrono::seconds(1));
+
+  // ֱcancel Ȼoperation_aborted
+  ioc.restart();
+  bool aborted = false;
+  in.async_read_some(buffer(data, sizeof(data)),
+                     with_timeout(in, std::chrono::seconds(10), [&](const std::error_code& ec, std::size_t) {
+                       assert(ec == detail::error_code::operation_aborted);
+                       aborted = true;
+                     }));
+  in.cancel();
+  ioc.run();
+  assert(aborted);
+
+  // ڻصcancelڼɵhandlerռס̵߳ȴcancelغִ
+  ioc.restart();
+  slow_object obj(ioc);
+  bool handed_off = false;
+  obj.async_wait(with_timeout(obj, std::chrono::milliseconds(5), handoff_handler{&obj, &handed_off}));
+  std::thread runner([&] { ioc.run(); });
+  ioc.run();
+  runner.join();
+  assert(handed_off);
+  assert(obj.ran_during_cancel_);
+  // ڻصhandler֮ͶݵĲhandlerԼķ
+  assert(allocations == 2 && live_allocations == 0);
+
+  std::cout << "read " << read << " bytes before timeout\n";
+  return 0;
+}
+}  // namespace test_with_timeout
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <vector>
+#include "signal_blocker.hpp"
 #include "thread.hpp"
 
 namespace boost::asio::detail {
@@ -12,9 +13,11 @@ class thread_group
   thread_group() : first_(0) {}
   ~thread_group() { join(); }
 
+  // ̼̳߳дʱź ȫźţ첽źֻsignal_setͨsignalfd
   template <typename Function>
   void create_thread(Function&& func)
   {
+    signal_blocker sb;
     first_ = new item(std::forward<Function>(func), first_);
   }
 
@@ -1,108 +1,282 @@
 #ifndef BOOST_ASIO_DETAIL_THREAD_INFO_BASE_HPP
 #define BOOST_ASIO_DETAIL_THREAD_INFO_BASE_HPP
 
-#include <limits>
-#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "mutex.hpp"
 #include "noncopyable.hpp"
 
 namespace boost::asio::detail {
-class thread_info_base : private noncopyable
+
+// ÿ߳һݵСڴ滺
+// 1Сּ(64B~2KB)ÿһ޵ıؿҪ
+// 2ͷ¼棬߳ͷʱѹԶͷջ߳ȡ
+// 3߳˳󻺴汻Żע߳̽ӹܣԶͷԶͷŵĻ
+class thread_cache : private noncopyable
 {
  public:
-  struct default_tag
+  enum
   {
-    enum
-    {
-      mem_index = 0
-    };
+    min_class_size = 64,
+    num_size_classes = 6,
+    max_class_size = min_class_size << (num_size_classes - 1),
+    default_depth = 64
   };
 
-  struct awaitee_tag
+  // ͷ 16ֽڱ֤ûmax_align_t
+  struct alignas(alignof(std::max_align_t)) block_header
   {
-    enum
-    {
-      mem_index = 1
-    };
+    thread_cache* owner_;  // 0ʾκλ
+    std::size_t size_class_;
   };
 
-  thread_info_base()
+  struct free_block
   {
-    for (int i = 0; i < max_mem_index; i++) {
-      reusable_memory_[i] = 0;
+    free_block* next_;
+  };
+
+  // ǰ̵߳Ļ ״εʱӹ
+  static thread_cache* this_thread()
+  {
+    thread_holder& h = holder();
+    if (!h.cache_) {
+      h.cache_ = registry().acquire();
+    }
+    return h.cache_;
+  }
+
+  // ǰ߳еĻ ûʱ0
+  static thread_cache* this_thread_if_exists() { return holder().cache_; }
+
+  static std::size_t size_class(std::size_t size)
+  {
+    std::size_t c = 0;
+    for (std::size_t n = min_class_size; n < size; n <<= 1) {
+      ++c;
     }
+    return c;
   }
 
-  ~thread_info_base()
+  static void* allocate(thread_cache* cache, std::size_t size)
   {
-    for (int i = 0; i < max_mem_index; ++i) {
-      auto& ptr = reusable_memory_[i];
-      if (ptr) {
-        ::operator delete(ptr);
-        ptr = 0;
+    if (cache && size <= max_class_size) {
+      std::size_t c = size_class(size);
+      if (!cache->free_[c]) {
+        cache->drain_remote();
       }
+      if (free_block* b = cache->free_[c]) {
+        cache->free_[c] = b->next_;
+        --cache->count_[c];
+        block_header* h = reinterpret_cast<block_header*>(b);
+        h->owner_ = cache;  // ʱowner_ָ븲
+        return h + 1;
+      }
+      return new_block(cache, c, std::size_t(min_class_size) << c);
     }
+    return new_block(0, 0, size);
   }
 
-  static void* allocate(thread_info_base* this_thread, std::size_t size)
+  static void deallocate(void* pointer)
   {
-    return allocate(default_tag(), this_thread, size);
+    block_header* h = static_cast<block_header*>(pointer) - 1;
+    thread_cache* owner = h->owner_;
+    if (!owner) {
+      ::operator delete(h);
+    } else if (owner == this_thread_if_exists()) {
+      owner->push_local(h);
+    } else {
+      owner->push_remote(h);
+    }
   }
 
-  static void deallocate(thread_info_base* this_thread, void* pointer, std::size_t size)
+  // ÿ Ŀֱӻϵͳ
+  static void set_depth(std::size_t depth) { depth_.store(depth, std::memory_order_relaxed); }
+  static std::size_t depth() { return depth_.load(std::memory_order_relaxed); }
+
+  // ߵ::operator newĴ
+  static std::size_t heap_allocations() { return heap_allocations_.load(std::memory_order_relaxed); }
+
+ private:
+  thread_cache() : remote_(0), next_(0)
   {
-    deallocate(default_tag(), this_thread, pointer, size);
+    for (std::size_t i = 0; i < num_size_classes; ++i) {
+      free_[i] = 0;
+      count_[i] = 0;
+    }
   }
 
-  template <typename Purpose>
-  static void* allocate(Purpose, thread_info_base* this_thread, std::size_t size)
+  ~thread_cache()
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
-    if (this_thread && this_thread->reusable_memory_[Purpose::mem_index]) {
-      void* pointer = this_thread->reusable_memory_[Purpose::mem_index];
-      this_thread->reusable_memory_[Purpose::mem_index] = 0;
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= chunks) {
-        mem[size] = mem[0];
-        return pointer;
+    drain_remote();
+    for (std::size_t i = 0; i < num_size_classes; ++i) {
+      while (free_block* b = free_[i]) {
+        free_[i] = b->next_;
+        ::operator delete(b);
       }
-      ::operator delete(pointer);
     }
+  }
 
-    void* const pointer = ::operator new((chunk_size * chunks) + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    if (chunks <= std::numeric_limits<unsigned char>::max()) {
-      mem[size] = static_cast<unsigned char>(chunks);
-    } else {
-      mem[size] = 0;
+  static void* new_block(thread_cache* owner, std::size_t size_class, std::size_t size)
+  {
+    heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+    block_header* h = static_cast<block_header*>(::operator new(sizeof(block_header) + size));
+    h->owner_ = owner;
+    h->size_class_ = size_class;
+    return h + 1;
+  }
+
+  void push_local(block_header* h)
+  {
+    std::size_t c = h->size_class_;
+    if (count_[c] >= depth()) {
+      ::operator delete(h);
+      return;
     }
-    return pointer;
+    free_block* b = reinterpret_cast<free_block*>(h);
+    b->next_ = free_[c];
+    free_[c] = b;
+    ++count_[c];
   }
 
-  template <typename Purpose>
-  static void deallocate(Purpose, thread_info_base* this_thread, void* pointer, std::size_t size)
-  {
-    if (size <= chunk_size * std::numeric_limits<unsigned char>::max()) {
-      if (this_thread && !this_thread->reusable_memory_[Purpose::mem_index]) {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_[Purpose::mem_index] = pointer;
-        return;
+  // ߵջ ߳һȡ ûABA
+  void push_remote(block_header* h)
+  {
+    free_block* b = reinterpret_cast<free_block*>(h);
+    free_block* head = remote_.load(std::memory_order_relaxed);
+    do {
+      b->next_ = head;
+    } while (!remote_.compare_exchange_weak(head, b, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  void drain_remote()
+  {
+    if (!remote_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    free_block* b = remote_.exchange(0, std::memory_order_acquire);
+    while (b) {
+      free_block* next = b->next_;
+      push_local(reinterpret_cast<block_header*>(b));
+      b = next;
+    }
+  }
+
+  // л涼ע עͻ
+  // ̬(ȫio_context)ʱͷŵĿȻԽػ
+  class cache_registry : private noncopyable
+  {
+   public:
+    cache_registry() : all_(), idle_() {}
+
+    thread_cache* acquire()
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (!idle_.empty()) {
+        thread_cache* c = idle_.back();
+        idle_.pop_back();
+        return c;
+      }
+      thread_cache* c = new thread_cache;
+      c->next_ = all_;
+      all_ = c;
+      return c;
+    }
+
+    void release(thread_cache* c)
+    {
+      mutex::scoped_lock lock(mutex_);
+      idle_.push_back(c);
+    }
+
+   private:
+    mutex mutex_;
+    thread_cache* all_;
+    std::vector<thread_cache*> idle_;
+  };
+
+  // ߳˳ʱѻ潻ע
+  struct thread_holder
+  {
+    thread_holder() : cache_(0) {}
+    ~thread_holder()
+    {
+      if (cache_) {
+        registry().release(cache_);
+        cache_ = 0;
       }
     }
-    ::operator delete(pointer);
+    thread_cache* cache_;
+  };
+
+  static cache_registry& registry()
+  {
+    static cache_registry& r = *new cache_registry;
+    return r;
   }
 
- private:
-  enum
+  static thread_holder& holder()
   {
-    chunk_size = 4
+    static thread_local thread_holder h;
+    return h;
+  }
+
+  free_block* free_[num_size_classes];
+  std::size_t count_[num_size_classes];
+  alignas(64) std::atomic<free_block*> remote_;
+  thread_cache* next_;
+
+  static inline std::atomic<std::size_t> depth_{default_depth};
+  static inline std::atomic<std::size_t> heap_allocations_{0};
+};
+
+class thread_info_base : private noncopyable
+{
+ public:
+  struct default_tag
+  {
+    enum
+    {
+      mem_index = 0
+    };
   };
-  enum
+
+  struct awaitee_tag
   {
-    max_mem_index = 2
+    enum
+    {
+      mem_index = 1
+    };
   };
-  void* reusable_memory_[max_mem_index];
+
+  thread_info_base() {}
+  ~thread_info_base() {}
+
+  static void* allocate(thread_info_base* this_thread, std::size_t size)
+  {
+    return allocate(default_tag(), this_thread, size);
+  }
+
+  static void deallocate(thread_info_base* this_thread, void* pointer, std::size_t size)
+  {
+    deallocate(default_tag(), this_thread, pointer, size);
+  }
+
+  // ֻڵ߳߻ ֱ߳ӷ䣬ͷΪκλ
+  // СּPurposeҪĲλݾɽӿ
+  template <typename Purpose>
+  static void* allocate(Purpose, thread_info_base* this_thread, std::size_t size)
+  {
+    return thread_cache::allocate(this_thread ? thread_cache::this_thread() : 0, size);
+  }
+
+  template <typename Purpose>
+  static void deallocate(Purpose, thread_info_base*, void* pointer, std::size_t)
+  {
+    thread_cache::deallocate(pointer);
+  }
 };
 }  // namespace boost::asio::detail
 
-#endif
\ No newline at end of file
+#endif
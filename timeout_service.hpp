@@ -0,0 +1,136 @@
+#ifndef BOOST_ASIO_DETAIL_TIMEOUT_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_TIMEOUT_SERVICE_HPP
+
+#include <atomic>
+#include <chrono>
+#include "chrono_time_traits.hpp"
+#include "detail_deadline_timer_service.hpp"
+#include "epoll_reactor.hpp"
+#include "io_context.hpp"
+#include "recycling_allocator.hpp"
+#include "service_registry_helpers.hpp"
+#include "wait_op.hpp"
+
+namespace boost::asio::detail {
+
+// with_timeoutʹõĶʱ ÿʱֻڶʱռһper_timer_data
+class timeout_service : public service_base<timeout_service>
+{
+ public:
+  using time_traits = chrono_time_traits<std::chrono::steady_clock, wait_traits<std::chrono::steady_clock>>;
+  using timer_queue_type = default_timer_queue<time_traits>;
+
+  // ڻصobject_.cancel()ʱɵhandler ɵڻصcancelͶ
+  class deferred_handler
+  {
+   public:
+    virtual void post() = 0;
+
+   protected:
+    ~deferred_handler() {}
+  };
+
+  // ʱ״̬ Ƕʱеwait_opʱ͸handlerͬ
+  // ʱȡObjectϵĲʱȡʱ
+  template <typename Object>
+  class state : public wait_op
+  {
+   public:
+    state(timeout_service& service, Object& object)
+        : wait_op(&state::do_complete), service_(service), object_(object), deferred_(0), status_(0), refs_(1)
+    {}
+
+    void add_ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release()
+    {
+      if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        this->~state();
+        recycling_allocator<state>().deallocate(this, 1);
+      }
+    }
+
+    //  ǷѾʱ ûгʱʱȡʱ
+    // ʱĶʱѾ뿪УҪȡ
+    bool complete()
+    {
+      if (status_.fetch_or(completed, std::memory_order_acq_rel) & (cancelling | cancelled)) {
+        return true;
+      }
+      service_.scheduler_.cancel_timer(service_.timer_queue_, timer_data_);
+      return false;
+    }
+
+    io_context& context() { return service_.get_io_context(); }
+
+    // ڻصǷobject_.cancel()
+    bool cancelling_in_progress() const { return status_.load(std::memory_order_acquire) & cancelling; }
+
+    // handlerڻص falseʾcancelѾɵ÷Լִ
+    bool defer(deferred_handler* handler)
+    {
+      deferred_ = handler;
+      return status_.fetch_or(deferred, std::memory_order_acq_rel) & cancelling;
+    }
+
+   private:
+    friend class timeout_service;
+
+    enum
+    {
+      cancelling = 1,
+      completed = 2,
+      cancelled = 4,
+      deferred = 8
+    };
+
+    // ڲʱȡ cancelڼɵhandlerȴcancelͶ
+    static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
+    {
+      state* s(static_cast<state*>(base));
+      if (owner && !s->ec_) {
+        if (!(s->status_.fetch_or(cancelling, std::memory_order_acq_rel) & completed)) {
+          s->object_.cancel();
+          // ͬʱcancellingcancelled
+          if (s->status_.fetch_xor(cancelling | cancelled, std::memory_order_acq_rel) & deferred) {
+            s->deferred_->post();
+          }
+        }
+      }
+      s->release();
+    }
+
+    timeout_service& service_;
+    Object& object_;
+    timer_queue_type::per_timer_data timer_data_;
+    deferred_handler* deferred_;
+    std::atomic<int> status_;
+    std::atomic<long> refs_;
+  };
+
+  timeout_service(io_context& ioc) : service_base<timeout_service>(ioc), scheduler_(use_service<epoll_reactor>(ioc))
+  {
+    scheduler_.init_task();
+    scheduler_.add_timer_queue(timer_queue_);
+  }
+
+  ~timeout_service() { scheduler_.remove_timer_queue(timer_queue_); }
+
+  void shutdown() {}
+
+  // ״̬ʱ ص״̬һøhandler
+  template <typename Object>
+  state<Object>* start(Object& object, const std::chrono::nanoseconds& timeout)
+  {
+    state<Object>* s = new (recycling_allocator<state<Object>>().allocate(1)) state<Object>(*this, object);
+    s->add_ref();
+    scheduler_.schedule_timer(timer_queue_, time_traits::add(time_traits::now(), timeout), s->timer_data_, s);
+    return s;
+  }
+
+ private:
+  timer_queue_type timer_queue_;
+  epoll_reactor& scheduler_;
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_TIMEOUT_SERVICE_HPP
@@ -20,13 +20,18 @@ class timer_queue : public timer_queue_base
   class per_timer_data
   {
    public:
-    per_timer_data() : heap_index_(std::numeric_limits<std::size_t>::max()), next_(0), prev_(0) {}
+    per_timer_data() : heap_index_(std::numeric_limits<std::size_t>::max()), group_(0), next_(0), prev_(0) {}
+
+    //  0ʾκη
+    std::size_t group() const { return group_; }
+    void set_group(std::size_t group) { group_ = group; }
 
    private:
     friend class timer_queue;
 
     op_queue<wait_op> op_queue_;  // ʱwait_op
     std::size_t heap_index_;      // ʱСеid
+    std::size_t group_;
     per_timer_data* next_;
     per_timer_data* prev_;
   };
@@ -87,8 +92,11 @@ class timer_queue : public timer_queue_base
   {
     if (!heap_.empty()) {
       const time_point now = T::now();
+      this->record_size(heap_.size());
       while (!heap_.empty() && !T::less_than(now, heap_[0].time_)) { // Ƿʱ
         per_timer_data* timer = heap_[0].timer_;
+        this->record_ready(timer->op_queue_,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(T::subtract(now, heap_[0].time_)));
         ops.push(timer->op_queue_);
         this->remove_timer(*timer); // Ƴʱ
       }
@@ -127,6 +135,31 @@ class timer_queue : public timer_queue_base
     return num_cancelled;
   }
 
+  // ȡgroupеĶʱ һؽһζ
+  std::size_t cancel_group(std::size_t group, op_queue<operation>& ops)
+  {
+    std::size_t num_cancelled = 0;
+    bool rebuild = false;
+    per_timer_data* timer = timers_;
+    while (timer) {
+      per_timer_data* next = timer->next_;
+      if (timer->group_ == group) {
+        num_cancelled += this->abort_ops(timer->op_queue_, ops);
+        if (timer->heap_index_ < heap_.size()) {
+          heap_[timer->heap_index_].timer_ = 0;
+          rebuild = true;
+        }
+        timer->heap_index_ = std::numeric_limits<std::size_t>::max();
+        unlink_timer(*timer);
+      }
+      timer = next;
+    }
+    if (rebuild) {
+      rebuild_heap();
+    }
+    return num_cancelled;
+  }
+
   // ƶʱ
   void move_timer(per_timer_data target, per_timer_data& source)
   {
@@ -194,38 +227,6 @@ class timer_queue : public timer_queue_base
   // ʱʱǷֵ
   static bool is_positive_infinity(const time_point& time) { return time == time_point::max(); }
 
-  // ʱתnans-->msec
-  long to_msec(const duration& d, long max_duration) const
-  {
-    if (d.count() < 0) {
-      return 0;
-    }
-    int64_t msec = d.count() / 1000000;
-    if (msec == 0) {
-      return 1;
-    }
-    if (msec > max_duration) {
-      return max_duration;
-    }
-    return static_cast<long>(msec);
-  }
-
-  // ʱתnans-->usec
-  long to_usec(const duration& d, long max_duration) const
-  {
-    if (d.count() < 0) {
-      return 0;
-    }
-    int64_t usec = d.count() / 1000;
-    if (usec == 0) {
-      return 1;
-    }
-    if (usec > max_duration) {
-      return max_duration;
-    }
-    return static_cast<long>(usec);
-  }
-
   // Ƴʱ
   void remove_timer(per_timer_data& timer)
   {
@@ -249,7 +250,12 @@ class timer_queue : public timer_queue_base
       }
     }
 
-    // Ƴʱ
+    unlink_timer(timer);
+  }
+
+  // Ƴʱ
+  void unlink_timer(per_timer_data& timer)
+  {
     if (timers_ == &timer) {
       timers_ = timers_->next_;
     }
@@ -263,6 +269,23 @@ class timer_queue : public timer_queue_base
     timer.prev_ = 0;
   }
 
+  // ȥѾɾ ԵϽ
+  void rebuild_heap()
+  {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < heap_.size(); ++i) {
+      if (heap_[i].timer_) {
+        heap_[n] = heap_[i];
+        heap_[n].timer_->heap_index_ = n;
+        ++n;
+      }
+    }
+    heap_.resize(n);
+    for (std::size_t i = n / 2; i-- > 0;) {
+      down_heap(i);
+    }
+  }
+
   per_timer_data* timers_; // ʱ洢
 
   // С
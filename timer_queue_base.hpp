@@ -1,16 +1,23 @@
 #ifndef BOOST_ASIO_DETAIL_TIMER_QUEUE_BASE_HPP
 #define BOOST_ASIO_DETAIL_TIMER_QUEUE_BASE_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "cached_clock.hpp"
+#include "error_code.hpp"
 #include "noncopyable.hpp"
 #include "op_queue.hpp"
 #include "scheduler_operation.hpp"
+#include "timer_statistics.hpp"
+#include "wait_op.hpp"
 
 namespace boost::asio::detail {
 // timer_queue
 class timer_queue_base : private noncopyable
 {
  public:
-  timer_queue_base() : next_(0) {}
+  timer_queue_base() : next_(0), queue_delay_(0) {}
   virtual ~timer_queue_base() {}
 
   virtual bool empty() const = 0;
@@ -19,9 +26,130 @@ class timer_queue_base : private noncopyable
   virtual void get_ready_timers(op_queue<operation>& ops) = 0;
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
+  // ͳ reactormutex_µãǰ¼Ҳֱͼ
+  virtual void enable_statistics()
+  {
+    if (!own_queue_delay_) {
+      own_queue_delay_.reset(new queue_delay_histogram);
+    }
+    enable_statistics(*own_queue_delay_);
+  }
+
+  // ȴʱǵqueue_delay sharded_timer_queueĸƬһ
+  void enable_statistics(queue_delay_histogram& queue_delay)
+  {
+    if (!statistics_) {
+      statistics_.reset(new queue_statistics);
+    }
+    queue_delay_ = &queue_delay;
+  }
+
+  // ϲstatistics ȡʱ
+  virtual void merge_statistics(timer_statistics& statistics) const
+  {
+    if (statistics_) {
+      statistics.lateness.merge(statistics_->lateness);
+      statistics.heap_size.merge(statistics_->heap_size);
+    }
+    if (own_queue_delay_) {
+      own_queue_delay_->merge_to(statistics.queue_delay);
+    }
+  }
+
+  virtual void reset_statistics()
+  {
+    if (statistics_) {
+      statistics_->lateness.reset();
+      statistics_->heap_size.reset();
+    }
+    if (own_queue_delay_) {
+      own_queue_delay_->reset();
+    }
+  }
+
+ protected:
+  // ȡʱеĲ ظ
+  static std::size_t abort_ops(op_queue<wait_op>& timer_ops, op_queue<operation>& ops)
+  {
+    std::size_t n = 0;
+    while (wait_op* op = timer_ops.front()) {
+      op->ec_ = error_code::operation_aborted;
+      timer_ops.pop();
+      ops.push(op);
+      ++n;
+    }
+    return n;
+  }
+
+  // ÿμ鵽ʱ¼дС
+  void record_size(std::size_t size)
+  {
+    if (statistics_) {
+      statistics_->heap_size.record(static_cast<std::int64_t>(size));
+    }
+  }
+
+  // ʱ ¼ٵʱ䣬ÿwait_ophandlerִǰ¼ȴʱ
+  void record_ready(op_queue<wait_op>& ops, const std::chrono::nanoseconds& lateness)
+  {
+    if (!statistics_) {
+      return;
+    }
+    statistics_->lateness.record(lateness.count());
+    std::int64_t ready_time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            cached_clock<std::chrono::steady_clock>::now().time_since_epoch())
+            .count();
+    for (wait_op* op = ops.front(); op; op = op_queue_access::next(op)) {
+      op->set_ready(queue_delay_, ready_time);
+    }
+  }
+
+  // ʱתnans-->msec
+  static long to_msec(const std::chrono::nanoseconds& d, long max_duration)
+  {
+    if (d.count() < 0) {
+      return 0;
+    }
+    int64_t msec = d.count() / 1000000;
+    if (msec == 0) {
+      return 1;
+    }
+    if (msec > max_duration) {
+      return max_duration;
+    }
+    return static_cast<long>(msec);
+  }
+
+  // ʱתnans-->usec
+  static long to_usec(const std::chrono::nanoseconds& d, long max_duration)
+  {
+    if (d.count() < 0) {
+      return 0;
+    }
+    int64_t usec = d.count() / 1000;
+    if (usec == 0) {
+      return 1;
+    }
+    if (usec > max_duration) {
+      return max_duration;
+    }
+    return static_cast<long>(usec);
+  }
+
  private:
   friend class timer_queue_set;
+  // ֻɳжĵڼд
+  struct queue_statistics
+  {
+    hdr_histogram lateness;
+    hdr_histogram heap_size;
+  };
+
   timer_queue_base* next_;
+  std::unique_ptr<queue_statistics> statistics_;
+  std::unique_ptr<queue_delay_histogram> own_queue_delay_;
+  queue_delay_histogram* queue_delay_;
 };
 
 template <typename T>
@@ -77,6 +77,28 @@ class timer_queue_set
     }
   }
 
+  void enable_statistics()
+  {
+    for (auto p = first_; p; p = p->next_) {
+      p->enable_statistics();
+    }
+  }
+
+  // ϲжеͳ
+  void merge_statistics(timer_statistics& statistics) const
+  {
+    for (auto p = first_; p; p = p->next_) {
+      p->merge_statistics(statistics);
+    }
+  }
+
+  void reset_statistics()
+  {
+    for (auto p = first_; p; p = p->next_) {
+      p->reset_statistics();
+    }
+  }
+
  private:
   timer_queue_base* first_;
 };
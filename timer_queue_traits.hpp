@@ -0,0 +1,25 @@
+#ifndef BOOST_ASIO_DETAIL_TIMER_QUEUE_TRAITS_HPP
+#define BOOST_ASIO_DETAIL_TIMER_QUEUE_TRAITS_HPP
+
+#include <chrono>
+
+namespace boost::asio::detail {
+
+// ʱ ʱػ
+// use_timing_wheel0ʱʱӵĶʱʹtiming_wheeltickΪʱֵľ
+// heap_arityΪ48ʱʹdary_timer_queueʹötimer_queue
+// timer_shards1ʱ̷ֳ߳ɶƬÿƬһѡĶ
+template <typename Clock>
+struct timer_queue_traits
+{
+  enum
+  {
+    use_timing_wheel = 0,
+    heap_arity = 2,
+    timer_shards = 0
+  };
+
+  static std::chrono::nanoseconds tick() { return std::chrono::milliseconds(1); }
+};
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_TIMER_QUEUE_TRAITS_HPP
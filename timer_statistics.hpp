@@ -0,0 +1,144 @@
+#ifndef BOOST_ASIO_TIMER_STATISTICS_HPP
+#define BOOST_ASIO_TIMER_STATISTICS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace boost::asio {
+
+// HDRֱͼ С64ֵȷ¼֮ÿ2ٵȷֳ32Ͱ1/32
+// relaxedԭӱ¼Ͷȡڲͬ߳
+class hdr_histogram
+{
+ public:
+  enum
+  {
+    sub_bucket_bits = 5,
+    sub_bucket_count = 1 << sub_bucket_bits,
+    max_magnitude = 47,  // 2^48ֵǵһͰ
+    bucket_count = (max_magnitude - sub_bucket_bits + 1) * sub_bucket_count + sub_bucket_count
+  };
+
+  hdr_histogram() { reset(); }
+  hdr_histogram(const hdr_histogram& other) { *this = other; }
+
+  hdr_histogram& operator=(const hdr_histogram& other)
+  {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts_[i].store(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    total_.store(other.total_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    max_.store(other.max_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  void record(std::int64_t value)
+  {
+    std::uint64_t v = value < 0 ? 0 : static_cast<std::uint64_t>(value);
+    counts_[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t m = max_.load(std::memory_order_relaxed);
+    while (v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed)) {
+    }
+  }
+
+  // ϲһֱͼ
+  void merge(const hdr_histogram& other)
+  {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts_[i].fetch_add(other.counts_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    total_.fetch_add(other.total_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    std::uint64_t v = other.max_.load(std::memory_order_relaxed);
+    std::uint64_t m = max_.load(std::memory_order_relaxed);
+    while (v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset()
+  {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      counts_[i].store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  std::uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+  std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  // percentileȡ[0, 100] ظ÷λͰϽ
+  std::uint64_t value_at_percentile(double percentile) const
+  {
+    std::uint64_t total = count();
+    if (total == 0) {
+      return 0;
+    }
+    std::uint64_t target = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+    if (target == 0) {
+      target = 1;
+    }
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        std::uint64_t upper = highest_equivalent_value(i);
+        std::uint64_t m = max();
+        return upper < m ? upper : m;
+      }
+    }
+    return max();
+  }
+
+ private:
+  static std::size_t bucket(std::uint64_t v)
+  {
+    if (v < 2 * sub_bucket_count) {
+      return static_cast<std::size_t>(v);
+    }
+    int magnitude = 63 - __builtin_clzll(v);
+    if (magnitude > max_magnitude) {
+      return bucket_count - 1;
+    }
+    int shift = magnitude - sub_bucket_bits;
+    return static_cast<std::size_t>(shift) * sub_bucket_count + static_cast<std::size_t>(v >> shift);
+  }
+
+  static std::uint64_t highest_equivalent_value(std::size_t i)
+  {
+    if (i < 2 * sub_bucket_count) {
+      return i;
+    }
+    std::size_t shift = i / sub_bucket_count - 1;
+    std::uint64_t top = i % sub_bucket_count + sub_bucket_count;
+    return ((top + 1) << shift) - 1;
+  }
+
+  std::atomic<std::uint64_t> counts_[bucket_count];
+  std::atomic<std::uint64_t> total_;
+  std::atomic<std::uint64_t> max_;
+};
+
+// ʱеͳ ʱ䵥λΪ
+struct timer_statistics
+{
+  hdr_histogram lateness;     // get_ready_timersʱѾʱ
+  hdr_histogram queue_delay;  // ںȶhandlerſʼִ
+  hdr_histogram heap_size;    // ÿμ鵽ʱеĶʱ
+
+  void merge(const timer_statistics& other)
+  {
+    lateness.merge(other.lateness);
+    queue_delay.merge(other.queue_delay);
+    heap_size.merge(other.heap_size);
+  }
+
+  void reset()
+  {
+    lateness.reset();
+    queue_delay.reset();
+    heap_size.reset();
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_TIMER_STATISTICS_HPP
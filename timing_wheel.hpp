@@ -0,0 +1,334 @@
+#ifndef BOOST_ASIO_DETAIL_TIMING_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMING_WHEEL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include "error_code.hpp"
+#include "timer_queue_base.hpp"
+#include "timer_queue_traits.hpp"
+#include "wait_op.hpp"
+
+namespace boost::asio::detail {
+
+// ֲϣʱ ȡO(1)
+// ÿ64ۣlһ۸64^ltick11㸲ȫ64λtick
+// ʱtick͵ǰtickߵĲͬ6λӦ㣬ǰtickòʱ·
+// ÿһ64λռλͼһڵĲ
+template <typename T>
+class timing_wheel : public timer_queue_base
+{
+ public:
+  using time_point = typename T::time_point;  // ʱ
+  using duration = typename T::duration;      // ʱ
+
+  enum
+  {
+    slot_bits = 6,
+    slots = 1 << slot_bits,
+    levels = 11,
+    ready_list = levels * slots,     // Ѿ
+    infinite_list = ready_list + 1,  // 
+    num_lists = infinite_list + 1
+  };
+
+  // ʱ
+  class per_timer_data
+  {
+   public:
+    per_timer_data() : tick_(0), list_(not_queued), group_(0), next_(0), prev_(0) {}
+
+    //  0ʾκη
+    std::size_t group() const { return group_; }
+    void set_group(std::size_t group) { group_ = group; }
+
+   private:
+    friend class timing_wheel;
+
+    op_queue<wait_op> op_queue_;  // ʱwait_op
+    std::uint64_t tick_;          // tick
+    std::size_t list_;            //  not_queuedʾڶ
+    std::size_t group_;
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  explicit timing_wheel(std::chrono::nanoseconds tick = timer_queue_traits<typename T::clock_type>::tick())
+      : origin_(T::now()), tick_(tick.count() > 0 ? tick.count() : 1), current_(0), count_(0)
+  {
+    for (std::size_t i = 0; i < levels; ++i) {
+      bitmap_[i] = 0;
+    }
+    for (std::size_t i = 0; i < num_lists; ++i) {
+      lists_[i] = 0;
+    }
+  }
+
+  std::chrono::nanoseconds tick() const { return std::chrono::nanoseconds(tick_); }
+
+  // ʱӵ ǷҪreactorĳʱ
+  bool enqueue_timer(const time_point& time, per_timer_data& timer, wait_op* op)
+  {
+    bool earliest = false;
+    if (timer.list_ == not_queued) {
+      if (time == time_point::max()) {
+        link(timer, infinite_list);
+      } else {
+        std::uint64_t next = next_tick();
+        timer.tick_ = to_tick(time);
+        place(timer);
+        earliest = next_tick() < next;
+      }
+    }
+    timer.op_queue_.push(op);
+    return earliest && timer.op_queue_.front() == op;
+  }
+
+  virtual bool empty() const { return count_ == 0; }
+
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    std::int64_t ns = 0;
+    if (!wait_duration(ns)) {
+      return max_duration;
+    }
+    return this->to_msec(std::chrono::nanoseconds(ns), max_duration);
+  }
+
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    std::int64_t ns = 0;
+    if (!wait_duration(ns)) {
+      return max_duration;
+    }
+    return this->to_usec(std::chrono::nanoseconds(ns), max_duration);
+  }
+
+  // ƽǰtick ;·Ÿ߲Ĳ۲ȡڵĶʱ
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (count_ == 0) {
+      return;
+    }
+    const std::uint64_t now = now_tick();
+    this->record_size(count_);
+    for (;;) {
+      std::uint64_t next = next_tick();
+      if (next > now) {
+        break;
+      }
+      if (next > current_) {
+        current_ = next;
+        cascade();
+      }
+      while (per_timer_data* timer = lists_[ready_list]) {
+        this->record_ready(timer->op_queue_,
+                           std::chrono::nanoseconds(static_cast<std::int64_t>(now - timer->tick_) * tick_));
+        ops.push(timer->op_queue_);
+        unlink(*timer);
+      }
+    }
+    if (current_ < now) {
+      current_ = now;
+    }
+  }
+
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < num_lists; ++i) {
+      while (per_timer_data* timer = lists_[i]) {
+        ops.push(timer->op_queue_);
+        unlink(*timer);
+      }
+    }
+  }
+
+  // ȡʱ
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+                           std::size_t max_cancelled = std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.list_ != not_queued) {
+      while (wait_op* op = (num_cancelled != max_cancelled) ? timer.op_queue_.front() : 0) {
+        op->ec_ = error_code::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty()) {
+        unlink(timer);
+      }
+    }
+    return num_cancelled;
+  }
+
+  // ȡgroupеĶʱ ʱûжѣֱժ
+  std::size_t cancel_group(std::size_t group, op_queue<operation>& ops)
+  {
+    std::size_t num_cancelled = 0;
+    for (std::size_t i = 0; i < num_lists && count_ != 0; ++i) {
+      per_timer_data* timer = lists_[i];
+      while (timer) {
+        per_timer_data* next = timer->next_;
+        if (timer->group_ == group) {
+          num_cancelled += this->abort_ops(timer->op_queue_, ops);
+          unlink(*timer);
+        }
+        timer = next;
+      }
+    }
+    return num_cancelled;
+  }
+
+  // ƶʱ targetԭеĲѾȡ
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    target.op_queue_.push(source.op_queue_);
+    target.tick_ = source.tick_;
+    target.list_ = source.list_;
+    target.next_ = source.next_;
+    target.prev_ = source.prev_;
+    if (target.list_ != not_queued) {
+      if (target.prev_) {
+        target.prev_->next_ = &target;
+      } else {
+        lists_[target.list_] = &target;
+      }
+      if (target.next_) {
+        target.next_->prev_ = &target;
+      }
+    }
+    source.list_ = not_queued;
+    source.next_ = 0;
+    source.prev_ = 0;
+  }
+
+ private:
+  static const std::size_t not_queued = static_cast<std::size_t>(-1);
+
+  // ʱȡtick ֤ǰ
+  std::uint64_t to_tick(const time_point& time) const
+  {
+    std::int64_t ns = T::to_chrono_duration(T::subtract(time, origin_)).count();
+    if (ns <= 0) {
+      return 0;
+    }
+    return static_cast<std::uint64_t>(ns / tick_ + (ns % tick_ != 0));
+  }
+
+  std::uint64_t now_tick() const
+  {
+    std::int64_t ns = T::to_chrono_duration(T::subtract(T::now(), origin_)).count();
+    return ns <= 0 ? 0 : static_cast<std::uint64_t>(ns / tick_);
+  }
+
+  // һҪtick falseʾûжʱ
+  bool wait_duration(std::int64_t& ns) const
+  {
+    std::uint64_t next = next_tick();
+    if (next == std::numeric_limits<std::uint64_t>::max()) {
+      return false;
+    }
+    if (next > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max() / tick_)) {
+      return false;
+    }
+    ns = static_cast<std::int64_t>(next) * tick_ - T::to_chrono_duration(T::subtract(T::now(), origin_)).count();
+    return true;
+  }
+
+  // һҪtick ߲۷ز۵㣬ʱ·
+  std::uint64_t next_tick() const
+  {
+    if (lists_[ready_list]) {
+      return current_;
+    }
+    for (std::size_t level = 0; level < levels; ++level) {
+      const unsigned shift = static_cast<unsigned>(level * slot_bits);
+      const unsigned index = static_cast<unsigned>(current_ >> shift) & (slots - 1);
+      std::uint64_t mask = index == slots - 1 ? 0 : bitmap_[level] & (~std::uint64_t(0) << (index + 1));
+      if (mask) {
+        const unsigned upper_shift = shift + slot_bits;
+        std::uint64_t upper = upper_shift < 64 ? (current_ >> upper_shift) << upper_shift : 0;
+        return upper | (static_cast<std::uint64_t>(__builtin_ctzll(mask)) << shift);
+      }
+    }
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+
+  // tick͵ǰtickߵĲͬ6λ ۺǴڸò㵱ǰۺ
+  void place(per_timer_data& timer)
+  {
+    if (timer.tick_ <= current_) {
+      link(timer, ready_list);
+      return;
+    }
+    const std::size_t level = (63 - __builtin_clzll(timer.tick_ ^ current_)) / slot_bits;
+    const std::size_t slot = static_cast<std::size_t>(timer.tick_ >> (level * slot_bits)) & (slots - 1);
+    link(timer, level * slots + slot);
+    bitmap_[level] |= std::uint64_t(1) << slot;
+  }
+
+  // current_ĳµĲʱѲڵĶʱ·ŵ͵Ĳ 0ֱӷready_list
+  void cascade()
+  {
+    for (std::size_t level = 0; level < levels; ++level) {
+      const unsigned shift = static_cast<unsigned>(level * slot_bits);
+      if (level != 0 && (current_ & ((std::uint64_t(1) << shift) - 1)) != 0) {
+        break;
+      }
+      const std::size_t slot = static_cast<std::size_t>(current_ >> shift) & (slots - 1);
+      if (bitmap_[level] & (std::uint64_t(1) << slot)) {
+        per_timer_data* timer = lists_[level * slots + slot];
+        lists_[level * slots + slot] = 0;
+        bitmap_[level] &= ~(std::uint64_t(1) << slot);
+        while (timer) {
+          per_timer_data* next = timer->next_;
+          --count_;
+          place(*timer);
+          timer = next;
+        }
+      }
+    }
+  }
+
+  void link(per_timer_data& timer, std::size_t list)
+  {
+    timer.list_ = list;
+    timer.prev_ = 0;
+    timer.next_ = lists_[list];
+    if (timer.next_) {
+      timer.next_->prev_ = &timer;
+    }
+    lists_[list] = &timer;
+    ++count_;
+  }
+
+  void unlink(per_timer_data& timer)
+  {
+    if (timer.prev_) {
+      timer.prev_->next_ = timer.next_;
+    } else {
+      lists_[timer.list_] = timer.next_;
+    }
+    if (timer.next_) {
+      timer.next_->prev_ = timer.prev_;
+    }
+    if (timer.list_ < ready_list && lists_[timer.list_] == 0) {
+      bitmap_[timer.list_ / slots] &= ~(std::uint64_t(1) << (timer.list_ % slots));
+    }
+    timer.list_ = not_queued;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+    --count_;
+  }
+
+  const time_point origin_;   // tick 0Ӧʱ
+  const std::int64_t tick_;   // ÿtick
+  std::uint64_t current_;     // Ѿtick
+  std::size_t count_;         // еĶʱ
+  std::uint64_t bitmap_[levels];
+  per_timer_data* lists_[num_lists];
+};
+
+}  // namespace boost::asio::detail
+#endif  // !BOOST_ASIO_DETAIL_TIMING_WHEEL_HPP
@@ -22,6 +22,9 @@ class wait_handler : public wait_op
   static void do_complete(void* owner, operation* base, const std::error_code&, std::size_t)
   {
     wait_handler* h(static_cast<wait_handler*>(base));
+    if (owner) {
+      h->record_queue_delay();
+    }
     ptr p = {std::addressof(h->handler_), h, h};
     handler_work<Handler> w(h->handler_);
 
@@ -1,15 +1,83 @@
 #ifndef BOOST_ASIO_DETAIL_WAIT_OP_HPP
 #define BOOST_ASIO_DETAIL_WAIT_OP_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include "scheduler_operation.hpp"
+#include "timer_statistics.hpp"
 
 namespace boost::asio::detail {
 
+// ںȴhandlerִеʱ ִhandler̼߳¼
+// ̷߳д룬߳ͬһֱͼȡʱϲ
+class queue_delay_histogram
+{
+ public:
+  enum
+  {
+    stripes = 4
+  };
+
+  void record(std::int64_t value) { stripes_[this_thread_stripe()].record(value); }
+
+  void merge_to(hdr_histogram& histogram) const
+  {
+    for (std::size_t i = 0; i < stripes; ++i) {
+      histogram.merge(stripes_[i]);
+    }
+  }
+
+  void reset()
+  {
+    for (std::size_t i = 0; i < stripes; ++i) {
+      stripes_[i].reset();
+    }
+  }
+
+ private:
+  // ̵߳һμ¼ʱ
+  static std::size_t this_thread_stripe()
+  {
+    static std::atomic<std::size_t> next_stripe(0);
+    thread_local std::size_t index = next_stripe.fetch_add(1, std::memory_order_relaxed) % stripes;
+    return index;
+  }
+
+  hdr_histogram stripes_[stripes];
+};
+
 class wait_op : public scheduler_operation
 {
  public:
   std::error_code ec_;
-  wait_op(func_type func) : scheduler_operation(func) {}
+  wait_op(func_type func) : scheduler_operation(func), queue_delay_(0), ready_time_(0) {}
+
+  // ʱʱɶʱ
+  void set_ready(queue_delay_histogram* queue_delay, std::int64_t ready_time)
+  {
+    queue_delay_ = queue_delay;
+    ready_time_ = ready_time;
+  }
+
+  // handlerʼִǰ¼ȴʱ
+  void record_queue_delay()
+  {
+    if (queue_delay_) {
+      queue_delay_->record(steady_time() - ready_time_);
+      queue_delay_ = 0;
+    }
+  }
+
+  static std::int64_t steady_time()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+ private:
+  queue_delay_histogram* queue_delay_;
+  std::int64_t ready_time_;
 };
 
 }  // namespace boost::asio::detail
@@ -41,6 +41,11 @@ class waitable_timer_service : public detail::service_base<waitable_timer_servic
   std::size_t cancle_one(service_impl_type& impl, std::error_code& ec) { return service_impl_.cancle_one(impl, ec); }
 
   time_point expiry(const impl_type& impl) const { return service_impl_.expiry(impl); }
+  duration slack(const impl_type& impl) const { return service_impl_.slack(impl); }
+  void set_slack(impl_type& impl, const duration& slack) { service_impl_.set_slack(impl, slack); }
+  std::size_t group(const impl_type& impl) const { return service_impl_.group(impl); }
+  void set_group(impl_type& impl, std::size_t group) { service_impl_.set_group(impl, group); }
+  std::size_t cancel_group(std::size_t group, std::error_code& ec) { return service_impl_.cancel_group(group, ec); }
 
   std::size_t expires_at(impl_type& impl, const time_point& expiry_time, std::error_code& ec)
   {
@@ -0,0 +1,163 @@
+#ifndef BOOST_ASIO_WITH_TIMEOUT_HPP
+#define BOOST_ASIO_WITH_TIMEOUT_HPP
+
+#include <chrono>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "associated_allocator.hpp"
+#include "associated_executor.hpp"
+#include "error_code.hpp"
+#include "handler_alloc_helpers.hpp"
+#include "timeout_service.hpp"
+
+namespace boost::asio {
+namespace detail {
+
+// ʱȡڼɵhandlerĲ cancelͶݵhandlerִ
+template <typename Handler, typename Executor, typename... Args>
+class timeout_deferred_handler final : public timeout_service::deferred_handler
+{
+ public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(timeout_deferred_handler);
+
+  timeout_deferred_handler(Handler&& handler, const Executor& ex, std::error_code ec, Args&&... args)
+      : handler_(std::move(handler)), executor_(ex), args_(ec, std::forward<Args>(args)...)
+  {}
+
+  // 洢handlerķ ƳͷͶ
+  virtual void post()
+  {
+    ptr p = {std::addressof(handler_), this, this};
+    timeout_deferred_handler local(std::move(*this));
+    p.h = std::addressof(local.handler_);
+    p.reset();
+    Executor ex(local.executor_);
+    associated_allocator_t<Handler> alloc(get_associated_allocator(local.handler_));
+    ex.post(std::move(local), alloc);
+  }
+
+  // cancelѾ ɵһֱִ
+  void invoke()
+  {
+    ptr p = {std::addressof(handler_), this, this};
+    timeout_deferred_handler local(std::move(*this));
+    p.h = std::addressof(local.handler_);
+    p.reset();
+    local();
+  }
+
+  void operator()() { std::apply(handler_, std::move(args_)); }
+
+ private:
+  Handler handler_;
+  Executor executor_;
+  std::tuple<std::error_code, std::decay_t<Args>...> args_;
+};
+}  // namespace detail
+
+// ʱhandler ʱȡʱecoperation_abortedΪtimed_out
+template <typename Handler, typename Object>
+class timeout_handler
+{
+ public:
+  using state_type = detail::timeout_service::state<Object>;
+
+  timeout_handler(Handler&& handler, state_type* state) : handler_(std::move(handler)), state_(state) {}
+  timeout_handler(const Handler& handler, state_type* state) : handler_(handler), state_(state) {}
+
+  timeout_handler(const timeout_handler& other) : handler_(other.handler_), state_(other.state_)
+  {
+    if (state_) {
+      state_->add_ref();
+    }
+  }
+
+  timeout_handler(timeout_handler&& other) : handler_(std::move(other.handler_)), state_(other.state_)
+  {
+    other.state_ = 0;
+  }
+
+  timeout_handler& operator=(const timeout_handler&) = delete;
+
+  ~timeout_handler()
+  {
+    if (state_) {
+      state_->release();
+    }
+  }
+
+  template <typename... Args>
+  void operator()(std::error_code ec, Args&&... args)
+  {
+    if (state_ && state_->complete()) {
+      if (ec == detail::error_code::operation_aborted) {
+        ec = std::make_error_code(std::errc::timed_out);
+      }
+      // ڻصcancel handlercancelغͶ
+      if (state_->cancelling_in_progress()) {
+        using executor_type = associated_executor_t<Handler, io_context::executor_type>;
+        using deferred_type = detail::timeout_deferred_handler<Handler, executor_type, Args...>;
+        executor_type ex(get_associated_executor(handler_, state_->context().get_executor()));
+        typename deferred_type::ptr p = {std::addressof(handler_), deferred_type::ptr::allocate(handler_), 0};
+        p.p = new (p.v) deferred_type(std::move(handler_), ex, ec, std::forward<Args>(args)...);
+        deferred_type* d = p.p;
+        p.v = p.p = 0;
+        if (!state_->defer(d)) {
+          d->invoke();
+        }
+        return;
+      }
+    }
+    handler_(ec, std::forward<Args>(args)...);
+  }
+
+  Handler& get() { return handler_; }
+  const Handler& get() const { return handler_; }
+
+ private:
+  Handler handler_;
+  state_type* state_;
+};
+
+// timeoutûʱobject.cancel() ҪĶʱhandler
+// object.cancel()ȡobjectδɵĲͬʱедoperation_aborted
+// ʱhandlercancelغִ
+// async_read_some(buffer, with_timeout(descriptor, std::chrono::seconds(5), handler));
+template <typename Object, typename Rep, typename Period, typename Handler>
+timeout_handler<std::decay_t<Handler>, Object> with_timeout(Object& object,
+                                                           const std::chrono::duration<Rep, Period>& timeout,
+                                                           Handler&& handler)
+{
+  detail::timeout_service& service = use_service<detail::timeout_service>(object.get_executor().context());
+  return timeout_handler<std::decay_t<Handler>, Object>(
+      std::forward<Handler>(handler),
+      service.start(object, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)));
+}
+
+// associated_allocatorػ
+template <typename Handler, typename Object, typename Alloc>
+struct associated_allocator<timeout_handler<Handler, Object>, Alloc>
+{
+  using type = typename associated_allocator<Handler, Alloc>::type;
+
+  static type get(const timeout_handler<Handler, Object>& h, const Alloc& a = Alloc())
+  {
+    return associated_allocator<Handler, Alloc>::get(h.get(), a);
+  }
+};
+
+// associated_executorػ
+template <typename Handler, typename Object, typename Executor>
+struct associated_executor<timeout_handler<Handler, Object>, Executor>
+{
+  using type = typename associated_executor<Handler, Executor>::type;
+
+  static type get(const timeout_handler<Handler, Object>& h, const Executor& ex = Executor())
+  {
+    return associated_executor<Handler, Executor>::get(h.get(), ex);
+  }
+};
+}  // namespace boost::asio
+#endif  // !BOOST_ASIO_WITH_TIMEOUT_HPP